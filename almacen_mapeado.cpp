@@ -0,0 +1,150 @@
+// ============================================================================
+// AlmacenMapeado.cpp - Implementación del Almacén en Archivo Mapeado
+// ============================================================================
+
+#include "AlmacenMapeado.h"
+#include <iostream>
+
+#ifndef _WIN32
+
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+// Constructor
+AlmacenMapeado::AlmacenMapeado(const char* ruta, size_t capacidadInicial)
+    : fd(-1), datos(nullptr), capacidad(0), longitud(0), agotado(false) {
+    // Múltiplo de página para que el remapeo no deje colas sueltas
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    if(capacidadInicial < pagina) capacidadInicial = pagina;
+    capacidadInicial = (capacidadInicial + pagina - 1) / pagina * pagina;
+    
+    fd = open(ruta, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0) {
+        std::cerr << "Error al crear " << ruta << ": " << strerror(errno) << std::endl;
+        return;
+    }
+    
+    // Reservar bloques reales: sin ellos, un disco lleno sería un SIGBUS
+    int r = posix_fallocate(fd, 0, (off_t)capacidadInicial);
+    if(r != 0) {
+        std::cerr << "Error al reservar " << ruta << ": " << strerror(r) << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+    
+    void* p = mmap(nullptr, capacidadInicial, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(p == MAP_FAILED) {
+        std::cerr << "Error al mapear " << ruta << ": " << strerror(errno) << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+    
+    datos = (char*)p;
+    capacidad = capacidadInicial;
+    madvise(datos, capacidad, MADV_SEQUENTIAL);
+}
+
+// Destructor
+AlmacenMapeado::~AlmacenMapeado() {
+    if(datos) munmap(datos, capacidad);
+    if(fd >= 0) {
+        // El archivo queda con el mensaje exacto, sin la reserva sobrante
+        if(ftruncate(fd, (off_t)longitud) != 0) {
+            std::cerr << "Error al truncar el almacén: " << strerror(errno) << std::endl;
+        }
+        close(fd);
+    }
+}
+
+// Duplicar archivo y mapeo
+bool AlmacenMapeado::crecer() {
+    if(agotado || !datos) return false;
+    
+    size_t nueva = capacidad * 2;
+    int r = posix_fallocate(fd, (off_t)capacidad, (off_t)(nueva - capacidad));
+    if(r != 0) {
+        std::cerr << "[ERROR] El almacén en archivo no pudo crecer a " << nueva
+                  << " bytes: " << strerror(r) << std::endl;
+        agotado = true;
+        return false;
+    }
+
+#ifdef __linux__
+    void* p = mremap(datos, capacidad, nueva, MREMAP_MAYMOVE);
+#else
+    // Sin mremap: el contenido está en el archivo, basta con mapearlo de nuevo
+    munmap(datos, capacidad);
+    void* p = mmap(nullptr, nueva, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+#endif
+    if(p == MAP_FAILED) {
+        std::cerr << "[ERROR] No se pudo remapear el almacén: " << strerror(errno) << std::endl;
+#ifndef __linux__
+        datos = nullptr;
+#endif
+        agotado = true;
+        return false;
+    }
+    
+    datos = (char*)p;
+    capacidad = nueva;
+    madvise(datos, capacidad, MADV_SEQUENTIAL);
+    return true;
+}
+
+// Crecer y asignar páginas antes de usarlas
+bool AlmacenMapeado::prereservar(size_t bytes) {
+    while(capacidad < bytes) {
+        if(!crecer()) return false;
+    }
+    
+    // Escribir un byte por página en la zona libre (se trunca al cerrar)
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    for(size_t i = longitud; i < capacidad; i += pagina) datos[i] = '\0';
+    return true;
+}
+
+// Volcar a un descriptor
+bool AlmacenMapeado::volcar(int fdSalida) const {
+    size_t enviados = 0;
+
+#ifdef __linux__
+    // El mapeo es compartido: la caché de páginas ya tiene el contenido
+    off_t desde = 0;
+    while(enviados < longitud) {
+        ssize_t n = sendfile(fdSalida, fd, &desde, longitud - enviados);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) break;   // Destino no soportado: seguir con write()
+        enviados += (size_t)n;
+    }
+#endif
+
+    while(enviados < longitud) {
+        ssize_t n = write(fdSalida, datos + enviados, longitud - enviados);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        enviados += (size_t)n;
+    }
+    return true;
+}
+
+#else
+// ===== WINDOWS: sin mmap POSIX =====
+
+AlmacenMapeado::AlmacenMapeado(const char* ruta, size_t)
+    : fd(-1), datos(nullptr), capacidad(0), longitud(0), agotado(true) {
+    std::cerr << "Almacén en archivo no disponible en Windows (" << ruta << ")" << std::endl;
+}
+AlmacenMapeado::~AlmacenMapeado() {}
+bool AlmacenMapeado::crecer() { return false; }
+bool AlmacenMapeado::prereservar(size_t) { return false; }
+bool AlmacenMapeado::volcar(int) const { return false; }
+
+#endif // _WIN32
@@ -0,0 +1,117 @@
+// ============================================================================
+// AlmacenMapeado.h - Almacenamiento de la Carga en un Archivo Mapeado
+// ============================================================================
+
+#ifndef ALMACEN_MAPEADO_H
+#define ALMACEN_MAPEADO_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @class AlmacenMapeado
+ * @brief Arreglo de caracteres que crece dentro de un archivo mapeado
+ * 
+ * Respaldo alternativo de ListaDeCarga para capturas largas: los caracteres
+ * se escriben en un mapeo compartido del archivo, así que el sistema
+ * operativo puede desalojar a disco las regiones frías en lugar de
+ * mantenerlas en el heap. El archivo crece duplicándose (reserva de bloques
+ * + mremap), por lo que agregar es O(1) amortizado, y al cerrar se trunca
+ * al largo real: queda el mensaje decodificado tal cual.
+ * 
+ * Sólo disponible en sistemas POSIX; en Windows estaListo() es false.
+ */
+class AlmacenMapeado {
+private:
+    int fd;             ///< Descriptor del archivo de respaldo
+    char* datos;        ///< Inicio del mapeo
+    size_t capacidad;   ///< Bytes mapeados (= tamaño actual del archivo)
+    size_t longitud;    ///< Bytes escritos
+    bool agotado;       ///< El archivo ya no pudo crecer (disco lleno)
+    
+    /**
+     * @brief Duplica el archivo y el mapeo
+     * @return false si no hay espacio o falló el remapeo
+     */
+    bool crecer();
+
+public:
+    /**
+     * @brief Crea (o trunca) el archivo y lo mapea
+     * @param ruta Archivo de respaldo
+     * @param capacidadInicial Bytes reservados de entrada
+     */
+    AlmacenMapeado(const char* ruta, size_t capacidadInicial = 1 << 20);
+    
+    /**
+     * @brief Destructor - Trunca el archivo al largo escrito y lo cierra
+     */
+    ~AlmacenMapeado();
+    
+    AlmacenMapeado(const AlmacenMapeado&) = delete;
+    AlmacenMapeado& operator=(const AlmacenMapeado&) = delete;
+    
+    /**
+     * @brief Indica si el archivo se abrió y mapeó correctamente
+     */
+    bool estaListo() const { return datos != nullptr; }
+    
+    /**
+     * @brief Agrega un carácter al final
+     * @return false si el archivo no pudo crecer (el carácter se pierde)
+     */
+    bool agregar(char c) {
+        if(longitud == capacidad && !crecer()) return false;
+        datos[longitud++] = c;
+        return true;
+    }
+    
+    /**
+     * @brief Agrega un bloque de caracteres al final
+     * @param s Caracteres a agregar
+     * @param n Cantidad
+     * @return false si el archivo no pudo crecer (no se agrega nada)
+     */
+    bool agregar(const char* s, size_t n) {
+        while(capacidad - longitud < n) {
+            if(!crecer()) return false;
+        }
+        memcpy(datos + longitud, s, n);
+        longitud += n;
+        return true;
+    }
+    
+    /**
+     * @brief Hace crecer el archivo y toca sus páginas de antemano
+     * @param bytes Capacidad total deseada
+     * @return false si el archivo no pudo crecer
+     */
+    bool prereservar(size_t bytes);
+    
+    /**
+     * @brief Acceso directo al contenido mapeado
+     */
+    char* getDatos() const { return datos; }
+    
+    /**
+     * @brief Bytes escritos
+     */
+    size_t getLongitud() const { return longitud; }
+    
+    /**
+     * @brief Bytes mapeados actualmente
+     */
+    size_t getCapacidad() const { return capacidad; }
+    
+    /**
+     * @brief Vuelca el contenido a un descriptor sin pasar por iostream
+     * @param fdSalida Descriptor de destino (ej: STDOUT_FILENO)
+     * @return true si se escribió todo
+     * 
+     * Usa sendfile() desde el archivo cuando el sistema lo permite y si no
+     * write() directamente desde el mapeo.
+     */
+    bool volcar(int fdSalida) const;
+};
+
+#endif // ALMACEN_MAPEADO_H
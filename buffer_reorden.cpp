@@ -0,0 +1,124 @@
+// ============================================================================
+// BufferReorden.cpp - Implementación de la Ventana de Reordenamiento
+// ============================================================================
+
+#include "BufferReorden.h"
+
+// Constructor
+BufferReorden::BufferReorden(int tamVentana, int timeoutMs, unsigned long primeraSecuencia)
+    : ventana(tamVentana > 0 ? tamVentana : 1), timeoutHuecoMs(timeoutMs),
+      siguiente(primeraSecuencia), retenidas(0), inicioHueco(-1),
+      entregadas(0), perdidas(0), descartadas(0), maxRetenidas(0) {
+    ranuras = new TramaBase*[ventana];
+    for(int i = 0; i < ventana; i++) ranuras[i] = nullptr;
+}
+
+// Destructor
+BufferReorden::~BufferReorden() {
+    for(int i = 0; i < ventana; i++) {
+        delete ranuras[i];
+    }
+    delete[] ranuras;
+}
+
+// Insertar trama secuenciada
+void BufferReorden::insertar(TramaBase* trama, long long ahoraMs,
+                             EntregaTrama entregar, void* ctx) {
+    unsigned long s = trama->getSecuencia();
+    
+    // Tardía o duplicada: su turno ya pasó
+    if(s < siguiente) {
+        descartadas++;
+        delete trama;
+        return;
+    }
+    
+    // Fuera de la ventana
+    if(s - siguiente >= (unsigned long)ventana) {
+        if(entregadas == 0 && retenidas == 0) {
+            // Nada entregado todavía: alinear la ventana con el emisor
+            siguiente = s;
+        } else {
+            // Forzar avance hasta que la trama quepa: primero las retenidas
+            // (todas están dentro de la ventana actual), luego el resto del
+            // salto de una vez, sin recorrerlo secuencia por secuencia
+            unsigned long nuevaBase = s - (unsigned long)ventana + 1;
+            while(retenidas > 0 && siguiente < nuevaBase) {
+                saltar(entregar, ctx);
+            }
+            if(siguiente < nuevaBase) {
+                perdidas += nuevaBase - siguiente;
+                siguiente = nuevaBase;
+            }
+        }
+    }
+    
+    TramaBase*& ranura = ranuras[s % ventana];
+    if(ranura) {
+        descartadas++;
+        delete trama;
+        return;
+    }
+    
+    ranura = trama;
+    retenidas++;
+    if(retenidas > maxRetenidas) maxRetenidas = retenidas;
+    
+    entregarContiguas(entregar, ctx);
+    
+    // Hay tramas esperando detrás de un hueco: iniciar el conteo
+    if(retenidas > 0 && inicioHueco < 0) inicioHueco = ahoraMs;
+    avanzar(ahoraMs, entregar, ctx);
+}
+
+// Revisar timeout de hueco
+void BufferReorden::avanzar(long long ahoraMs, EntregaTrama entregar, void* ctx) {
+    if(retenidas == 0 || inicioHueco < 0) return;
+    if(ahoraMs - inicioHueco < timeoutHuecoMs) return;
+    
+    // El hueco expiró: saltar hasta la siguiente trama presente
+    while(!ranuras[siguiente % ventana]) {
+        siguiente++;
+        perdidas++;
+    }
+    entregarContiguas(entregar, ctx);
+    inicioHueco = (retenidas > 0) ? ahoraMs : -1;
+}
+
+// Entregar todo al final del flujo
+void BufferReorden::vaciar(EntregaTrama entregar, void* ctx) {
+    while(retenidas > 0) {
+        saltar(entregar, ctx);
+        entregarContiguas(entregar, ctx);
+    }
+    inicioHueco = -1;
+}
+
+// Entregar racha contigua
+void BufferReorden::entregarContiguas(EntregaTrama entregar, void* ctx) {
+    TramaBase* t;
+    while((t = ranuras[siguiente % ventana]) != nullptr) {
+        ranuras[siguiente % ventana] = nullptr;
+        retenidas--;
+        siguiente++;
+        entregadas++;
+        inicioHueco = -1;
+        entregar(t, ctx);
+    }
+}
+
+// Saltar secuencia esperada
+void BufferReorden::saltar(EntregaTrama entregar, void* ctx) {
+    TramaBase*& ranura = ranuras[siguiente % ventana];
+    if(ranura) {
+        TramaBase* t = ranura;
+        ranura = nullptr;
+        retenidas--;
+        siguiente++;
+        entregadas++;
+        entregar(t, ctx);
+    } else {
+        siguiente++;
+        perdidas++;
+    }
+}
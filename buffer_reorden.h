@@ -0,0 +1,99 @@
+// ============================================================================
+// BufferReorden.h - Ventana de Reordenamiento por Número de Secuencia
+// ============================================================================
+
+#ifndef BUFFER_REORDEN_H
+#define BUFFER_REORDEN_H
+
+#include "TramaBase.h"
+
+/**
+ * @brief Función que recibe cada trama liberada en orden
+ * @param trama Trama a procesar (el receptor se encarga de liberarla)
+ * @param contexto Puntero opaco registrado por quien inserta
+ */
+typedef void (*EntregaTrama)(TramaBase* trama, void* contexto);
+
+/**
+ * @class BufferReorden
+ * @brief Ventana acotada que devuelve las tramas en orden de secuencia
+ * 
+ * Se coloca antes de procesar() cuando las tramas llegan por varios
+ * enlaces y pueden adelantarse unas a otras. Las tramas se guardan en un
+ * arreglo circular indexado por (secuencia % ventana) y se entregan en
+ * cuanto forman una racha contigua desde la siguiente secuencia esperada.
+ * 
+ * Un hueco que no se llena en timeoutHuecoMs, o una trama que cae fuera
+ * de la ventana, hace avanzar la ventana contando las secuencias perdidas.
+ * Las tramas duplicadas o que llegan después de su turno se descartan.
+ */
+class BufferReorden {
+private:
+    TramaBase** ranuras;        ///< Tramas retenidas, indexadas por secuencia % ventana
+    int ventana;                ///< Cantidad máxima de secuencias en espera
+    int timeoutHuecoMs;         ///< Espera máxima por una secuencia faltante
+    
+    unsigned long siguiente;    ///< Próxima secuencia a entregar
+    int retenidas;              ///< Tramas actualmente en la ventana
+    long long inicioHueco;      ///< Instante en que se detectó el hueco actual (-1 si no hay)
+    
+    unsigned long entregadas;   ///< Tramas entregadas en orden
+    unsigned long perdidas;     ///< Secuencias saltadas sin llegar
+    unsigned long descartadas;  ///< Duplicadas o tardías
+    int maxRetenidas;           ///< Máxima ocupación observada
+    
+    /**
+     * @brief Entrega la racha contigua disponible desde 'siguiente'
+     */
+    void entregarContiguas(EntregaTrama entregar, void* ctx);
+    
+    /**
+     * @brief Salta la secuencia esperada (entregándola si está presente)
+     */
+    void saltar(EntregaTrama entregar, void* ctx);
+
+public:
+    /**
+     * @brief Constructor - Crea una ventana vacía
+     * @param tamVentana Cantidad de secuencias que se pueden retener
+     * @param timeoutMs Milisegundos de espera por un hueco antes de saltarlo
+     * @param primeraSecuencia Secuencia con la que empieza el emisor
+     */
+    BufferReorden(int tamVentana, int timeoutMs, unsigned long primeraSecuencia = 0);
+    
+    /**
+     * @brief Destructor - Libera las tramas que sigan retenidas
+     */
+    ~BufferReorden();
+    
+    /**
+     * @brief Inserta una trama con número de secuencia
+     * @param trama Trama recibida (la ventana toma posesión)
+     * @param ahoraMs Instante actual en milisegundos (reloj monótono)
+     * @param entregar Receptor de las tramas que quedan en orden
+     * @param ctx Contexto para el receptor
+     */
+    void insertar(TramaBase* trama, long long ahoraMs, EntregaTrama entregar, void* ctx);
+    
+    /**
+     * @brief Revisa el timeout de hueco sin que lleguen tramas nuevas
+     * @param ahoraMs Instante actual en milisegundos (reloj monótono)
+     * @param entregar Receptor de las tramas liberadas
+     * @param ctx Contexto para el receptor
+     */
+    void avanzar(long long ahoraMs, EntregaTrama entregar, void* ctx);
+    
+    /**
+     * @brief Entrega todo lo retenido al terminar el flujo, saltando huecos
+     * @param entregar Receptor de las tramas liberadas
+     * @param ctx Contexto para el receptor
+     */
+    void vaciar(EntregaTrama entregar, void* ctx);
+    
+    unsigned long getEntregadas() const { return entregadas; }     ///< Tramas entregadas
+    unsigned long getPerdidas() const { return perdidas; }         ///< Secuencias perdidas
+    unsigned long getDescartadas() const { return descartadas; }   ///< Duplicadas/tardías
+    int getMaxRetenidas() const { return maxRetenidas; }           ///< Ocupación máxima
+};
+
+#endif // BUFFER_REORDEN_H
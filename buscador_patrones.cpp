@@ -0,0 +1,233 @@
+// ============================================================================
+// BuscadorPatrones.cpp - Implementación del Autómata Aho-Corasick
+// ============================================================================
+
+#include "BuscadorPatrones.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <chrono>
+
+// Manejador por defecto: alerta en consola
+static void imprimirCoincidencia(const Coincidencia& c, void* /*contexto*/) {
+    std::cout << "[ALERTA] Patrón \"" << c.texto << "\" detectado en trama "
+              << c.indiceTrama << " (posición " << c.posicion << ", t="
+              << c.marcaTiempoMs / 1000 << "."
+              << std::setw(3) << std::setfill('0') << c.marcaTiempoMs % 1000
+              << std::setfill(' ') << ")" << std::endl;
+}
+
+// Constructor
+BuscadorPatrones::BuscadorPatrones()
+    : transiciones(nullptr), primeraSalida(nullptr), enlaceSalida(nullptr),
+      conSalida(nullptr), numEstados(0), patrones(nullptr),
+      siguienteMismoEstado(nullptr), numPatrones(0), estado(0), posicion(0),
+      totalCoincidencias(0), manejador(imprimirCoincidencia), contexto(nullptr) {}
+
+// Destructor
+BuscadorPatrones::~BuscadorPatrones() {
+    liberar();
+}
+
+// Liberar autómata y patrones
+void BuscadorPatrones::liberar() {
+    delete[] transiciones;
+    delete[] primeraSalida;
+    delete[] enlaceSalida;
+    delete[] conSalida;
+    for(int i = 0; i < numPatrones; i++) {
+        delete[] patrones[i];
+    }
+    delete[] patrones;
+    delete[] siguienteMismoEstado;
+    
+    transiciones = primeraSalida = enlaceSalida = siguienteMismoEstado = nullptr;
+    conSalida = nullptr;
+    patrones = nullptr;
+    numEstados = numPatrones = 0;
+}
+
+// Leer patrones desde archivo
+bool BuscadorPatrones::cargarArchivo(const char* ruta) {
+    FILE* f = fopen(ruta, "r");
+    if(!f) {
+        std::cerr << "Error al abrir archivo de patrones " << ruta << std::endl;
+        return false;
+    }
+    
+    // Primera pasada: contar líneas y rechazar las demasiado largas (fgets
+    // partiría en varios patrones las que no entran en el buffer)
+    char linea[MAX_PATRON + 3];     // Patrón + "\r\n" + '\0'
+    int capacidad = 0;
+    while(fgets(linea, sizeof(linea), f)) {
+        capacidad++;
+        size_t len = strcspn(linea, "\r\n");
+        if(len > (size_t)MAX_PATRON) {
+            std::cerr << "Error en " << ruta << ", línea " << capacidad
+                      << ": el patrón supera " << MAX_PATRON << " caracteres" << std::endl;
+            fclose(f);
+            return false;
+        }
+    }
+    rewind(f);
+    
+    char** lista = new char*[capacidad > 0 ? capacidad : 1];
+    int n = 0;
+    
+    while(n < capacidad && fgets(linea, sizeof(linea), f)) {
+        // Quitar fin de línea
+        int len = (int)strlen(linea);
+        while(len > 0 && (linea[len - 1] == '\n' || linea[len - 1] == '\r')) {
+            linea[--len] = '\0';
+        }
+        if(len == 0 || linea[0] == '#') continue;
+        
+        lista[n] = new char[len + 1];
+        memcpy(lista[n], linea, len + 1);
+        n++;
+    }
+    fclose(f);
+    
+    bool ok = compilar(lista, n);
+    
+    for(int i = 0; i < n; i++) delete[] lista[i];
+    delete[] lista;
+    return ok;
+}
+
+// Construir el autómata determinista
+bool BuscadorPatrones::compilar(const char* const* lista, int n) {
+    liberar();
+    
+    // Cota de estados: raíz + un estado por carácter de patrón
+    int maxEstados = 1;
+    for(int i = 0; i < n; i++) maxEstados += (int)strlen(lista[i]);
+    
+    transiciones = new int[maxEstados * 256];
+    primeraSalida = new int[maxEstados];
+    enlaceSalida = new int[maxEstados];
+    conSalida = new bool[maxEstados];
+    patrones = new char*[n > 0 ? n : 1];
+    siguienteMismoEstado = new int[n > 0 ? n : 1];
+    
+    for(int i = 0; i < maxEstados * 256; i++) transiciones[i] = -1;
+    for(int i = 0; i < maxEstados; i++) {
+        primeraSalida[i] = -1;
+        enlaceSalida[i] = -1;
+    }
+    numEstados = 1;
+    
+    // Construir el trie
+    for(int p = 0; p < n; p++) {
+        int len = (int)strlen(lista[p]);
+        patrones[p] = new char[len + 1];
+        memcpy(patrones[p], lista[p], len + 1);
+        
+        int s = 0;
+        for(int i = 0; i < len; i++) {
+            int c = (unsigned char)lista[p][i];
+            if(transiciones[s * 256 + c] == -1) {
+                transiciones[s * 256 + c] = numEstados++;
+            }
+            s = transiciones[s * 256 + c];
+        }
+        siguienteMismoEstado[p] = primeraSalida[s];
+        primeraSalida[s] = p;
+    }
+    numPatrones = n;
+    
+    // Recorrido en anchura: resolver fallos dentro de la tabla
+    int* fallo = new int[numEstados];
+    int* cola = new int[numEstados];
+    int frente = 0, fin = 0;
+    
+    fallo[0] = 0;
+    for(int c = 0; c < 256; c++) {
+        int t = transiciones[c];
+        if(t == -1) {
+            transiciones[c] = 0;
+        } else {
+            fallo[t] = 0;
+            cola[fin++] = t;
+        }
+    }
+    
+    while(frente < fin) {
+        int s = cola[frente++];
+        for(int c = 0; c < 256; c++) {
+            int t = transiciones[s * 256 + c];
+            int destinoFallo = transiciones[fallo[s] * 256 + c];
+            if(t == -1) {
+                transiciones[s * 256 + c] = destinoFallo;
+            } else {
+                fallo[t] = destinoFallo;
+                enlaceSalida[t] = (primeraSalida[destinoFallo] != -1)
+                                ? destinoFallo : enlaceSalida[destinoFallo];
+                cola[fin++] = t;
+            }
+        }
+    }
+    
+    for(int s = 0; s < numEstados; s++) {
+        conSalida[s] = (primeraSalida[s] != -1 || enlaceSalida[s] != -1);
+    }
+    // La raíz nunca reporta (no hay patrones vacíos útiles)
+    conSalida[0] = false;
+    
+    delete[] fallo;
+    delete[] cola;
+    
+    reiniciar();
+    return true;
+}
+
+// Avanzar con un carácter (una sola transición de tabla)
+void BuscadorPatrones::alInsertar(char dato, unsigned long indiceTrama) {
+    if(!transiciones) return;
+    
+    estado = transiciones[(estado << 8) | (unsigned char)dato];
+    if(conSalida[estado]) {
+        reportar(indiceTrama);
+    }
+    posicion++;
+}
+
+// Emitir coincidencias del estado actual
+void BuscadorPatrones::reportar(unsigned long indiceTrama) {
+    Coincidencia c;
+    c.indiceTrama = indiceTrama;
+    c.posicion = posicion;
+    c.marcaTiempoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    for(int s = estado; s != -1; s = enlaceSalida[s]) {
+        for(int p = primeraSalida[s]; p != -1; p = siguienteMismoEstado[p]) {
+            c.patron = p;
+            c.texto = patrones[p];
+            totalCoincidencias++;
+            manejador(c, contexto);
+        }
+    }
+}
+
+// Cambiar destino de eventos
+void BuscadorPatrones::setManejador(ManejadorCoincidencia m, void* ctx) {
+    manejador = m ? m : imprimirCoincidencia;
+    contexto = ctx;
+}
+
+// Reiniciar recorrido
+void BuscadorPatrones::reiniciar() {
+    estado = 0;
+    posicion = 0;
+    totalCoincidencias = 0;
+}
+
+int BuscadorPatrones::getNumPatrones() const {
+    return numPatrones;
+}
+
+unsigned long BuscadorPatrones::getTotalCoincidencias() const {
+    return totalCoincidencias;
+}
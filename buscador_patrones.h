@@ -0,0 +1,131 @@
+// ============================================================================
+// BuscadorPatrones.h - Búsqueda Multi-Patrón en Flujo (Aho-Corasick)
+// ============================================================================
+
+#ifndef BUSCADOR_PATRONES_H
+#define BUSCADOR_PATRONES_H
+
+#include "ObservadorCarga.h"
+
+/**
+ * @struct Coincidencia
+ * @brief Evento emitido cuando un patrón aparece en el mensaje decodificado
+ */
+struct Coincidencia {
+    int patron;                 ///< Índice del patrón dentro del archivo
+    const char* texto;          ///< Texto del patrón encontrado
+    unsigned long indiceTrama;  ///< Trama que completó la coincidencia
+    unsigned long posicion;     ///< Posición (base 0) del último carácter en el mensaje
+    long long marcaTiempoMs;    ///< Instante de detección (ms desde epoch)
+};
+
+/**
+ * @brief Función que recibe cada coincidencia detectada
+ * @param c Datos de la coincidencia
+ * @param contexto Puntero opaco registrado junto con el manejador
+ */
+typedef void (*ManejadorCoincidencia)(const Coincidencia& c, void* contexto);
+
+/**
+ * @class BuscadorPatrones
+ * @brief Autómata Aho-Corasick que vigila el flujo decodificado en vivo
+ * 
+ * Se compila una sola vez a partir de un archivo de patrones y se engancha
+ * a ListaDeCarga como observador. Las transiciones de fallo se resuelven
+ * durante la compilación (autómata determinista completo), de modo que cada
+ * carácter decodificado cuesta una sola consulta a la tabla de transiciones.
+ */
+class BuscadorPatrones : public ObservadorCarga {
+private:
+    int* transiciones;          ///< Tabla [estado * 256 + byte] -> estado siguiente
+    int* primeraSalida;         ///< Primer patrón que termina en cada estado (-1 si ninguno)
+    int* enlaceSalida;          ///< Siguiente estado con salida por la cadena de fallos (-1)
+    bool* conSalida;            ///< true si el estado reporta al menos un patrón
+    int numEstados;             ///< Cantidad de estados del autómata
+    
+    char** patrones;            ///< Copia de los patrones compilados
+    int* siguienteMismoEstado;  ///< Patrones que terminan en el mismo estado
+    int numPatrones;            ///< Cantidad de patrones
+    
+    int estado;                         ///< Estado actual del recorrido
+    unsigned long posicion;             ///< Caracteres consumidos hasta ahora
+    unsigned long totalCoincidencias;   ///< Coincidencias emitidas
+    
+    ManejadorCoincidencia manejador;    ///< Destino de los eventos
+    void* contexto;                     ///< Contexto del manejador
+    
+    /**
+     * @brief Libera el autómata y los patrones compilados
+     */
+    void liberar();
+    
+    /**
+     * @brief Emite todas las coincidencias que terminan en el estado actual
+     * @param indiceTrama Trama que produjo el último carácter
+     */
+    void reportar(unsigned long indiceTrama);
+
+public:
+    static const int MAX_PATRON = 255;  ///< Caracteres máximos de un patrón en archivo
+    
+    /**
+     * @brief Constructor - Crea un buscador sin patrones
+     * 
+     * El manejador por defecto imprime una alerta en consola.
+     */
+    BuscadorPatrones();
+    
+    /**
+     * @brief Destructor - Libera tablas y patrones
+     */
+    ~BuscadorPatrones();
+    
+    /**
+     * @brief Compila el autómata a partir de un archivo de patrones
+     * @param ruta Archivo con un patrón por línea
+     * @return true si el archivo se leyó y compiló correctamente
+     * 
+     * Las líneas vacías y las que empiezan con '#' se ignoran. Una línea
+     * de más de MAX_PATRON caracteres es un error (se informa su número).
+     */
+    bool cargarArchivo(const char* ruta);
+    
+    /**
+     * @brief Compila el autómata a partir de un arreglo de patrones
+     * @param lista Patrones terminados en '\0' (se copian)
+     * @param n Cantidad de patrones
+     * @return true si se compiló correctamente
+     */
+    bool compilar(const char* const* lista, int n);
+    
+    /**
+     * @brief Avanza el autómata con un carácter decodificado
+     * @param dato Carácter recién insertado en la lista de carga
+     * @param indiceTrama Trama que lo produjo
+     */
+    void alInsertar(char dato, unsigned long indiceTrama) override;
+    
+    /**
+     * @brief Reemplaza el destino de los eventos de coincidencia
+     * @param m Función a invocar por cada coincidencia
+     * @param ctx Contexto opaco que se pasará a la función
+     */
+    void setManejador(ManejadorCoincidencia m, void* ctx);
+    
+    /**
+     * @brief Vuelve al estado inicial sin recompilar
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Cantidad de patrones compilados
+     */
+    int getNumPatrones() const;
+    
+    /**
+     * @brief Cantidad de coincidencias emitidas desde el último reinicio
+     */
+    unsigned long getTotalCoincidencias() const;
+};
+
+#endif // BUSCADOR_PATRONES_H
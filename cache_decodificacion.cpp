@@ -0,0 +1,309 @@
+// ============================================================================
+// CacheDecodificacion.cpp - Implementación de la Caché de Resultados
+// ============================================================================
+
+#include "CacheDecodificacion.h"
+#include <iostream>
+
+#ifndef _WIN32
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+static const uint32_t MAGIA_ENTRADA = 0x43375250;   // "PR7C"
+static const uint32_t VERSION_ENTRADA = 2;          // Subir si cambia la decodificación (2: tramas B)
+static const char* EXTENSION = ".prt7c";
+static const int LARGO_RUTA = 800;                  // Directorio (512) + nombre
+
+/**
+ * @struct CabeceraEntrada
+ * @brief Cabecera de un archivo de la caché
+ */
+struct CabeceraEntrada {
+    uint32_t magia;         ///< MAGIA_ENTRADA
+    uint32_t version;       ///< VERSION_ENTRADA
+    uint64_t claveAlta;     ///< Clave completa, para descartar nombres ajenos
+    uint64_t claveBaja;
+    uint64_t tramas;        ///< Tramas válidas
+    uint64_t malformadas;   ///< Líneas inválidas
+    uint64_t caracteres;    ///< Bytes del mensaje que siguen a la cabecera
+};
+
+/**
+ * @struct EntradaDirectorio
+ * @brief Datos de una entrada para ordenar por antigüedad
+ */
+struct EntradaDirectorio {
+    struct timespec modificada;
+    long long bytes;
+    char nombre[48];
+};
+
+// Más antigua primero (con nanosegundos: varios usos caen en el mismo segundo)
+static int compararAntiguedad(const void* a, const void* b) {
+    const struct timespec& x = ((const EntradaDirectorio*)a)->modificada;
+    const struct timespec& y = ((const EntradaDirectorio*)b)->modificada;
+    if(x.tv_sec != y.tv_sec) return x.tv_sec < y.tv_sec ? -1 : 1;
+    return x.tv_nsec < y.tv_nsec ? -1 : (x.tv_nsec > y.tv_nsec ? 1 : 0);
+}
+
+// Escribir todo el bloque
+static bool escribirTodo(int fd, const char* datos, size_t n) {
+    while(n > 0) {
+        ssize_t w = write(fd, datos, n);
+        if(w < 0 && errno == EINTR) continue;
+        if(w <= 0) return false;
+        datos += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+// Constructor
+CacheDecodificacion::CacheDecodificacion(const char* dir, long long maximo, const TablaMapeo& tabla,
+                                         int desplazamiento, bool estricto)
+    : maxBytes(maximo), lista(false), bytesDesdePoda(0), contador(0), aciertos(0), fallos(0) {
+    strncpy(directorio, dir, sizeof(directorio) - 1);
+    directorio[sizeof(directorio) - 1] = '\0';
+    
+    // Firma: versión del formato, tablas del rotor, desplazamiento y parser
+    Hash128 h(VERSION_ENTRADA);
+    int tamanio = tabla.getTamanio();
+    h.actualizar(&tamanio, sizeof(tamanio));
+    for(int k = 0; k < tamanio; k++) h.actualizar(tabla.tabla(k), 256);
+    int d = tabla.normalizar(desplazamiento);
+    h.actualizar(&d, sizeof(d));
+    char e = estricto ? 1 : 0;
+    h.actualizar(&e, 1);
+    firma = h.finalizar();
+    
+    if(mkdir(directorio, 0755) != 0 && errno != EEXIST) {
+        std::cerr << "[ERROR] No se pudo crear la caché " << directorio << ": "
+                  << strerror(errno) << std::endl;
+        return;
+    }
+    lista = true;
+}
+
+// Destructor: una poda final deja la caché bajo el máximo actual,
+// aunque se haya reducido desde la ejecución anterior
+CacheDecodificacion::~CacheDecodificacion() {
+    if(lista) podar();
+}
+
+// <dir>/<clave hex>.prt7c
+void CacheDecodificacion::rutaEntrada(const Huella128& clave, char* ruta, int max) const {
+    char hex[33];
+    clave.aHex(hex);
+    snprintf(ruta, max, "%s/%s%s", directorio, hex, EXTENSION);
+}
+
+// Clave = hash(firma || datos)
+Huella128 CacheDecodificacion::clave(const char* datos, size_t n) const {
+    Hash128 h;
+    h.actualizar(&firma, sizeof(firma));
+    h.actualizar(datos, n);
+    return h.finalizar();
+}
+
+// Buscar y copiar
+bool CacheDecodificacion::buscar(const Huella128& clave, EntradaCache& entrada, int fdSalida) {
+    char ruta[LARGO_RUTA];
+    rutaEntrada(clave, ruta, sizeof(ruta));
+    
+    int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+        fallos++;
+        return false;
+    }
+    
+    CabeceraEntrada cab;
+    struct stat st;
+    bool valida = read(fd, &cab, sizeof(cab)) == (ssize_t)sizeof(cab) && fstat(fd, &st) == 0 &&
+                  cab.magia == MAGIA_ENTRADA && cab.version == VERSION_ENTRADA &&
+                  cab.claveAlta == clave.alta && cab.claveBaja == clave.baja &&
+                  (uint64_t)st.st_size == sizeof(cab) + cab.caracteres;
+    if(!valida) {
+        close(fd);
+        fallos++;
+        return false;
+    }
+    
+    // Copiar el mensaje sin pasar por memoria del proceso cuando se puede
+    size_t restante = (size_t)cab.caracteres;
+#ifdef __linux__
+    off_t desde = sizeof(cab);
+    while(restante > 0) {
+        ssize_t n = sendfile(fdSalida, fd, &desde, restante);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) break;
+        restante -= (size_t)n;
+    }
+    // sendfile no mueve la posición del archivo: seguir desde lo ya copiado
+    if(restante > 0 && lseek(fd, desde, SEEK_SET) != desde) {
+        close(fd);
+        fallos++;
+        return false;
+    }
+#endif
+    char bloque[64 * 1024];
+    while(restante > 0) {
+        ssize_t n = read(fd, bloque, restante < sizeof(bloque) ? restante : sizeof(bloque));
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0 || !escribirTodo(fdSalida, bloque, (size_t)n)) break;
+        restante -= (size_t)n;
+    }
+    
+    // Uso reciente: la fecha de modificación es el orden LRU
+    futimens(fd, nullptr);
+    close(fd);
+    
+    if(restante > 0) {
+        fallos++;
+        return false;
+    }
+    
+    entrada.tramas = (unsigned long)cab.tramas;
+    entrada.malformadas = (unsigned long)cab.malformadas;
+    entrada.caracteres = (long)cab.caracteres;
+    aciertos++;
+    return true;
+}
+
+// Guardar en un temporal y publicar con rename
+bool CacheDecodificacion::guardar(const Huella128& clave, const EntradaCache& entrada,
+                                  const char* mensaje) {
+    if(!lista) return false;
+    
+    char temporal[LARGO_RUTA];
+    snprintf(temporal, sizeof(temporal), "%s/tmp.%ld.%lu", directorio,
+             (long)getpid(), contador++);
+    int fd = open(temporal, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if(fd < 0) return false;
+    
+    CabeceraEntrada cab;
+    memset(&cab, 0, sizeof(cab));
+    cab.magia = MAGIA_ENTRADA;
+    cab.version = VERSION_ENTRADA;
+    cab.claveAlta = clave.alta;
+    cab.claveBaja = clave.baja;
+    cab.tramas = entrada.tramas;
+    cab.malformadas = entrada.malformadas;
+    cab.caracteres = (uint64_t)entrada.caracteres;
+    
+    bool ok = escribirTodo(fd, (const char*)&cab, sizeof(cab)) &&
+              escribirTodo(fd, mensaje, (size_t)entrada.caracteres);
+    close(fd);
+    
+    char ruta[LARGO_RUTA];
+    rutaEntrada(clave, ruta, sizeof(ruta));
+    if(!ok || rename(temporal, ruta) != 0) {
+        unlink(temporal);
+        return false;
+    }
+    
+    // Desalojar cada vez que se escribió una octava parte del máximo
+    long long escritos = bytesDesdePoda += (long long)(sizeof(cab) + entrada.caracteres);
+    if(escritos > maxBytes / 8) podar();
+    return true;
+}
+
+// Desalojo LRU bajo flock
+void CacheDecodificacion::podar() {
+    char ruta[LARGO_RUTA];
+    snprintf(ruta, sizeof(ruta), "%s/.bloqueo", directorio);
+    int bloqueo = open(ruta, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(bloqueo < 0) return;
+    if(flock(bloqueo, LOCK_EX | LOCK_NB) != 0) {
+        // Otro proceso (u otro hilo) ya está desalojando
+        close(bloqueo);
+        return;
+    }
+    bytesDesdePoda = 0;
+    
+    DIR* dir = opendir(directorio);
+    if(!dir) {
+        close(bloqueo);
+        return;
+    }
+    
+    int capacidad = 256;
+    int n = 0;
+    EntradaDirectorio* entradas = new EntradaDirectorio[capacidad];
+    long long total = 0;
+    time_t ahora = time(nullptr);
+    
+    for(struct dirent* e = readdir(dir); e; e = readdir(dir)) {
+        const char* nombre = e->d_name;
+        size_t largo = strlen(nombre);
+        struct stat st;
+        snprintf(ruta, sizeof(ruta), "%s/%s", directorio, nombre);
+        
+        // Temporales abandonados por un proceso que murió a mitad de escritura
+        if(strncmp(nombre, "tmp.", 4) == 0) {
+            if(stat(ruta, &st) == 0 && ahora - st.st_mtime > 3600) unlink(ruta);
+            continue;
+        }
+        
+        size_t largoExt = strlen(EXTENSION);
+        if(largo >= sizeof(entradas[0].nombre) || largo <= largoExt ||
+           strcmp(nombre + largo - largoExt, EXTENSION) != 0) continue;
+        if(stat(ruta, &st) != 0) continue;
+        
+        if(n == capacidad) {
+            EntradaDirectorio* mayor = new EntradaDirectorio[capacidad * 2];
+            memcpy(mayor, entradas, sizeof(EntradaDirectorio) * n);
+            delete[] entradas;
+            entradas = mayor;
+            capacidad *= 2;
+        }
+        entradas[n].modificada = st.st_mtim;
+        entradas[n].bytes = (long long)st.st_size;
+        memcpy(entradas[n].nombre, nombre, largo + 1);
+        total += entradas[n].bytes;
+        n++;
+    }
+    closedir(dir);
+    
+    if(total > maxBytes) {
+        qsort(entradas, n, sizeof(EntradaDirectorio), compararAntiguedad);
+        long long objetivo = maxBytes / 10 * 9;
+        for(int i = 0; i < n && total > objetivo; i++) {
+            snprintf(ruta, sizeof(ruta), "%s/%s", directorio, entradas[i].nombre);
+            if(unlink(ruta) == 0) total -= entradas[i].bytes;
+        }
+    }
+    
+    delete[] entradas;
+    flock(bloqueo, LOCK_UN);
+    close(bloqueo);
+}
+
+#else
+// ===== WINDOWS: sin caché =====
+
+CacheDecodificacion::CacheDecodificacion(const char* dir, long long maximo, const TablaMapeo&,
+                                         int, bool)
+    : maxBytes(maximo), lista(false), bytesDesdePoda(0), contador(0), aciertos(0), fallos(0) {
+    directorio[0] = '\0';
+    std::cerr << "La caché de decodificación no está disponible en Windows (" << dir << ")" << std::endl;
+}
+CacheDecodificacion::~CacheDecodificacion() {}
+void CacheDecodificacion::rutaEntrada(const Huella128&, char*, int) const {}
+Huella128 CacheDecodificacion::clave(const char*, size_t) const { Huella128 h = { 0, 0 }; return h; }
+bool CacheDecodificacion::buscar(const Huella128&, EntradaCache&, int) { return false; }
+bool CacheDecodificacion::guardar(const Huella128&, const EntradaCache&, const char*) { return false; }
+void CacheDecodificacion::podar() {}
+
+#endif // _WIN32
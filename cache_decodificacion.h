@@ -0,0 +1,117 @@
+// ============================================================================
+// CacheDecodificacion.h - Caché en Disco de Resultados por Contenido
+// ============================================================================
+
+#ifndef CACHE_DECODIFICACION_H
+#define CACHE_DECODIFICACION_H
+
+#include <atomic>
+#include "Hash128.h"
+#include "TablaMapeo.h"
+
+/**
+ * @struct EntradaCache
+ * @brief Estadísticas guardadas junto con un mensaje decodificado
+ */
+struct EntradaCache {
+    unsigned long tramas;       ///< Tramas válidas
+    unsigned long malformadas;  ///< Líneas inválidas
+    long caracteres;            ///< Largo del mensaje
+};
+
+/**
+ * @class CacheDecodificacion
+ * @brief Resultados de decodificación direccionados por contenido
+ * 
+ * La clave es un Hash128 de los bytes crudos de la captura precedido por
+ * una firma de la configuración que influye en el resultado: las tablas
+ * del rotor (alfabeto y mapeo), el desplazamiento inicial y el modo del
+ * parser. Cada entrada es un archivo <clave>.prt7c en el directorio de
+ * la caché con una cabecera (estadísticas) y el mensaje.
+ * 
+ * Varios procesos pueden usar el mismo directorio a la vez:
+ * - Una entrada se escribe en un temporal y se publica con rename(), que
+ *   es atómico: un lector ve la entrada completa o no la ve.
+ * - Un acierto actualiza la fecha de modificación de la entrada, que es
+ *   el orden LRU para el desalojo.
+ * - El desalojo toma un flock() exclusivo sobre <dir>/.bloqueo; si otro
+ *   proceso ya está desalojando, se omite. Borrar una entrada abierta por
+ *   un lector no lo afecta (POSIX).
+ */
+class CacheDecodificacion {
+private:
+    char directorio[512];       ///< Directorio de la caché
+    long long maxBytes;         ///< Tamaño máximo antes de desalojar
+    Huella128 firma;            ///< Firma de la configuración
+    bool lista;                 ///< Directorio utilizable
+    
+    std::atomic<long long> bytesDesdePoda;  ///< Escrito desde el último desalojo
+    std::atomic<unsigned long> contador;    ///< Para nombres de temporales únicos
+    std::atomic<unsigned long> aciertos;    ///< Búsquedas encontradas
+    std::atomic<unsigned long> fallos;      ///< Búsquedas no encontradas
+    
+    /**
+     * @brief Ruta de la entrada de una clave
+     */
+    void rutaEntrada(const Huella128& clave, char* ruta, int max) const;
+
+public:
+    /**
+     * @brief Constructor - Crea el directorio si no existe
+     * @param dir Directorio de la caché
+     * @param maximo Bytes máximos de la caché
+     * @param tabla Tablas del rotor inicial (alfabeto y mapeo)
+     * @param desplazamiento Rotación inicial del rotor
+     * @param estricto Modo del parser
+     */
+    CacheDecodificacion(const char* dir, long long maximo, const TablaMapeo& tabla,
+                        int desplazamiento, bool estricto);
+    
+    /**
+     * @brief Desaloja lo que sobre al terminar
+     */
+    ~CacheDecodificacion();
+    
+    CacheDecodificacion(const CacheDecodificacion&) = delete;
+    CacheDecodificacion& operator=(const CacheDecodificacion&) = delete;
+    
+    /**
+     * @brief Indica si el directorio se pudo crear y usar
+     */
+    bool estaLista() const { return lista; }
+    
+    /**
+     * @brief Clave de una captura con la configuración de esta caché
+     * @param datos Bytes crudos de la captura
+     * @param n Cantidad de bytes
+     */
+    Huella128 clave(const char* datos, size_t n) const;
+    
+    /**
+     * @brief Busca una entrada y copia su mensaje a un descriptor
+     * @param clave Clave de la captura
+     * @param entrada Estadísticas guardadas (salida)
+     * @param fdSalida Descriptor donde escribir el mensaje
+     * @return false si no está o está dañada (fdSalida puede tener basura)
+     */
+    bool buscar(const Huella128& clave, EntradaCache& entrada, int fdSalida);
+    
+    /**
+     * @brief Guarda un resultado
+     * @param clave Clave de la captura
+     * @param entrada Estadísticas a guardar
+     * @param mensaje Mensaje decodificado (entrada.caracteres bytes)
+     * @return true si la entrada quedó publicada
+     */
+    bool guardar(const Huella128& clave, const EntradaCache& entrada, const char* mensaje);
+    
+    /**
+     * @brief Desaloja las entradas menos usadas hasta quedar bajo el 90% del máximo
+     */
+    void podar();
+    
+    unsigned long getAciertos() const { return aciertos; }  ///< Búsquedas encontradas
+    unsigned long getFallos() const { return fallos; }      ///< Búsquedas no encontradas
+};
+
+#endif // CACHE_DECODIFICACION_H
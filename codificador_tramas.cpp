@@ -0,0 +1,112 @@
+// ============================================================================
+// CodificadorTramas.cpp - Implementación del Codificador de Tramas
+// ============================================================================
+
+#include "CodificadorTramas.h"
+#include "TramaCargaMasiva.h"
+#include "ParserTramas.h"
+#include <cstdio>
+#include <cstring>
+
+// Constructor: tablas inversas del rotor para cada desplazamiento
+CodificadorTramas::CodificadorTramas(int mapaCadaN, bool secuencias, unsigned int semillaInicial)
+    : tabla(&rotor), desplazamiento(0), cadaN(mapaCadaN), maxMasiva(0), conSecuencia(secuencias),
+      secuencia(0), cargas(0), tramas(0), semilla(semillaInicial) {
+    inversa = new char[tabla.getTamanio()][256];
+    
+    for(int k = 0; k < tabla.getTamanio(); k++) {
+        for(int c = 0; c < 256; c++) inversa[k][c] = (char)c;
+        // Recorrer de atrás hacia adelante: gana el crudo más bajo
+        for(int c = 255; c >= 0; c--) {
+            inversa[k][(unsigned char)tabla.tabla(k)[c]] = (char)c;
+        }
+    }
+}
+
+// Destructor
+CodificadorTramas::~CodificadorTramas() {
+    delete[] inversa;
+}
+
+// Tramas B en lugar de L
+void CodificadorTramas::setCargaMasiva(int maxPorTrama) {
+    if(maxPorTrama < 0) maxPorTrama = 0;
+    if(maxPorTrama > TramaCargaMasiva::MAX_CARGA) maxPorTrama = TramaCargaMasiva::MAX_CARGA;
+    maxMasiva = maxPorTrama;
+}
+
+// Escribir una línea
+int CodificadorTramas::emitir(char* salida, int capacidad, const char* cuerpo) {
+    char linea[LARGO_MAX_LINEA + 2];
+    int n;
+    if(conSecuencia) {
+        n = snprintf(linea, sizeof(linea), "%lu:%s\n", secuencia, cuerpo);
+    } else {
+        n = snprintf(linea, sizeof(linea), "%s\n", cuerpo);
+    }
+    if(n <= 0 || n > capacidad) return 0;
+    
+    memcpy(salida, linea, n);
+    secuencia++;
+    tramas++;
+    return n;
+}
+
+// Codificar mensaje
+int CodificadorTramas::codificar(const char* mensaje, int n, char* salida,
+                                 int capacidad, int* consumidos) {
+    int escritos = 0;
+    int i = 0;
+    
+    for(; i < n; i++) {
+        char claro = mensaje[i];
+        if(claro == '\n' || claro == '\r') continue;
+        
+        // Reservar espacio para un posible MAP más la carga
+        if(capacidad - escritos < 64 + maxMasiva) break;
+        
+        if(cadaN > 0 && cargas > 0 && cargas % cadaN == 0) {
+            // Rotación pseudoaleatoria en [-5, 5], distinta de 0
+            semilla = semilla * 1103515245u + 12345u;
+            int r = (int)((semilla >> 16) % 10) - 5;
+            if(r >= 0) r++;
+            
+            char cuerpo[16];
+            snprintf(cuerpo, sizeof(cuerpo), "M,%d", r);
+            escritos += emitir(salida + escritos, capacidad - escritos, cuerpo);
+            desplazamiento = tabla.normalizar(desplazamiento + r);
+        }
+        
+        if(maxMasiva > 0) {
+            // Juntar caracteres hasta el tope sin cruzar el próximo MAP
+            int limite = maxMasiva;
+            if(cadaN > 0) {
+                int faltan = cadaN - (int)(cargas % cadaN);
+                if(faltan < limite) limite = faltan;
+            }
+            
+            char crudos[TramaCargaMasiva::MAX_CARGA];
+            int largo = 0;
+            for(; i < n && largo < limite; i++) {
+                if(mensaje[i] == '\n' || mensaje[i] == '\r') continue;
+                crudos[largo++] = inversa[desplazamiento][(unsigned char)mensaje[i]];
+            }
+            i--;    // El for externo avanza
+            
+            char cuerpo[TramaCargaMasiva::MAX_CARGA + 16];
+            int prefijo = snprintf(cuerpo, sizeof(cuerpo), "B,%d,", largo);
+            memcpy(cuerpo + prefijo, crudos, largo);
+            cuerpo[prefijo + largo] = '\0';
+            escritos += emitir(salida + escritos, capacidad - escritos, cuerpo);
+            cargas += largo;
+            continue;
+        }
+        
+        char cuerpo[4] = { 'L', ',', inversa[desplazamiento][(unsigned char)claro], '\0' };
+        escritos += emitir(salida + escritos, capacidad - escritos, cuerpo);
+        cargas++;
+    }
+    
+    if(consumidos) *consumidos = i;
+    return escritos;
+}
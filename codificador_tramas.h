@@ -0,0 +1,81 @@
+// ============================================================================
+// CodificadorTramas.h - Generación de Tramas PRT-7 a partir de un Mensaje
+// ============================================================================
+
+#ifndef CODIFICADOR_TRAMAS_H
+#define CODIFICADOR_TRAMAS_H
+
+#include "RotorDeMapeo.h"
+#include "TablaMapeo.h"
+
+/**
+ * @class CodificadorTramas
+ * @brief Inverso del decodificador: convierte texto en tramas LOAD/MAP
+ * 
+ * Hace el papel del transmisor (Arduino) para pruebas y herramientas:
+ * intercala tramas MAP con rotaciones pseudoaleatorias y elige para cada
+ * carácter el dato crudo que, con la rotación vigente, el RotorDeMapeo
+ * decodifica como el carácter original.
+ * 
+ * Con setCargaMasiva() los caracteres entre dos MAP se agrupan en tramas
+ * de carga masiva "B,N,XXXX" en lugar de una trama "L,X" por carácter.
+ */
+class CodificadorTramas {
+private:
+    RotorDeMapeo rotor;         ///< Rotor de referencia (estado inicial)
+    TablaMapeo tabla;           ///< Mapeo por desplazamiento
+    char (*inversa)[256];       ///< inversa[k][claro] = crudo
+    int desplazamiento;         ///< Rotación vigente del receptor
+    int cadaN;                  ///< Insertar un MAP cada cadaN cargas (0 = nunca)
+    int maxMasiva;              ///< Caracteres por trama B (0 = tramas L)
+    bool conSecuencia;          ///< Anteponer "S:" a cada trama
+    unsigned long secuencia;    ///< Próximo número de secuencia
+    unsigned long cargas;       ///< Cargas emitidas
+    unsigned long tramas;       ///< Tramas emitidas (LOAD + MAP)
+    unsigned int semilla;       ///< Estado del generador pseudoaleatorio
+    
+    /**
+     * @brief Escribe una trama (con prefijo de secuencia si corresponde)
+     * @return Bytes escritos, o 0 si no hay espacio
+     */
+    int emitir(char* salida, int capacidad, const char* cuerpo);
+
+public:
+    /**
+     * @brief Constructor
+     * @param mapaCadaN Insertar un MAP cada N cargas (0 = sin rotaciones)
+     * @param secuencias true para numerar las tramas ("S:L,X")
+     * @param semillaInicial Semilla de las rotaciones pseudoaleatorias
+     */
+    CodificadorTramas(int mapaCadaN, bool secuencias, unsigned int semillaInicial = 7);
+    
+    /**
+     * @brief Destructor - Libera las tablas inversas
+     */
+    ~CodificadorTramas();
+    
+    /**
+     * @brief Agrupa las cargas en tramas de carga masiva
+     * @param maxPorTrama Caracteres por trama B (0 vuelve a tramas L;
+     *                    se limita a TramaCargaMasiva::MAX_CARGA)
+     */
+    void setCargaMasiva(int maxPorTrama);
+    
+    /**
+     * @brief Codifica un mensaje como líneas "L,X" (o "B,N,XXXX") / "M,N"
+     * @param mensaje Texto a transmitir ('\n' y '\r' se omiten)
+     * @param n Largo del mensaje
+     * @param salida Buffer de salida
+     * @param capacidad Tamaño del buffer
+     * @param consumidos Caracteres del mensaje que se alcanzaron a codificar
+     * @return Bytes escritos en salida
+     */
+    int codificar(const char* mensaje, int n, char* salida, int capacidad, int* consumidos);
+    
+    /**
+     * @brief Tramas emitidas hasta ahora
+     */
+    unsigned long getTramas() const { return tramas; }
+};
+
+#endif // CODIFICADOR_TRAMAS_H
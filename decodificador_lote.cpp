@@ -0,0 +1,669 @@
+// ============================================================================
+// DecodificadorLote.cpp - Implementación del Modo Lote
+// ============================================================================
+
+#include "DecodificadorLote.h"
+#include <iostream>
+
+#ifndef _WIN32
+
+#include "SesionDecodificador.h"
+#include "ParserTramas.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+#include "Traza.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @struct ArchivoLote
+ * @brief Una captura del lote y su resultado
+ */
+struct ArchivoLote {
+    char* ruta;                 ///< Captura de entrada
+    char* salida;               ///< Archivo de resultado
+    size_t bytes;               ///< Tamaño de la captura
+    const char* datos;          ///< Mapeo de la captura (sólo si se parte)
+    int numTrozos;              ///< 0 = se decodifica completa en un grupo
+    TrozoLote* trozos;          ///< Trozos de una captura grande
+    std::atomic<int> restantes; ///< Trozos que faltan en la fase en curso
+    int fdSalida;               ///< Resultado abierto durante la fase 3
+    unsigned long tramas;       ///< Tramas válidas
+    unsigned long malformadas;  ///< Líneas inválidas
+    long caracteres;            ///< Caracteres decodificados
+    std::atomic<long long> inicioNs;    ///< Comienzo del primer trabajo sobre la captura
+    long long finNs;            ///< Fin del último
+    bool error;                 ///< No se pudo leer o escribir
+    Huella128 clave;            ///< Clave en la caché
+    char estadoCache;           ///< '-' sin caché, 'A' acierto, 'F' fallo
+    DecodificadorLote* lote;    ///< Dueño (tabla y pool)
+};
+
+/**
+ * @struct TrozoLote
+ * @brief Tramo de una captura grande, cortado en límite de línea
+ */
+struct TrozoLote {
+    ArchivoLote* archivo;       ///< Captura a la que pertenece
+    size_t desde;               ///< Primer byte del trozo
+    size_t hasta;               ///< Byte siguiente al último
+    char* crudos;               ///< Fase 1: carga cruda de cada LOAD
+    unsigned char* relativos;   ///< Fase 1: rotación acumulada (normalizada) antes de cada carga
+    long cargas;                ///< Cantidad de cargas
+    long capacidad;             ///< Tamaño de crudos/relativos
+    long rotacion;              ///< Rotación neta del trozo
+    long inicioSalida;          ///< Fase 2: posición del trozo en el resultado
+    long desplazamiento;        ///< Fase 2: rotación acumulada al comenzar el trozo
+    unsigned long tramas;       ///< Tramas válidas del trozo
+    unsigned long malformadas;  ///< Líneas inválidas del trozo
+};
+
+/**
+ * @struct GrupoLote
+ * @brief Capturas pequeñas decodificadas por una misma tarea
+ */
+struct GrupoLote {
+    ArchivoLote** archivos;     ///< Capturas del grupo
+    int cantidad;               ///< Cantidad de capturas
+};
+
+// Reloj monótono en nanosegundos
+static long long ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Copia en el heap de una cadena
+static char* duplicar(const char* s) {
+    size_t n = strlen(s);
+    char* d = new char[n + 1];
+    memcpy(d, s, n + 1);
+    return d;
+}
+
+// Lugar para 'extra' cargas más en los arreglos de fase 1 del trozo
+static void asegurarCapacidad(TrozoLote* t, long extra) {
+    if(t->cargas + extra <= t->capacidad) return;
+    long nueva = t->capacidad * 2;
+    if(nueva < t->cargas + extra) nueva = t->cargas + extra;
+    
+    char* crudos = new char[nueva];
+    unsigned char* relativos = new unsigned char[nueva];
+    memcpy(crudos, t->crudos, t->cargas);
+    memcpy(relativos, t->relativos, t->cargas);
+    delete[] t->crudos;
+    delete[] t->relativos;
+    t->crudos = crudos;
+    t->relativos = relativos;
+    t->capacidad = nueva;
+}
+
+// Escribir todo el bloque en una posición
+static bool escribirEn(int fd, const char* datos, size_t n, off_t pos) {
+    TRAZA_INTERVALO("escribir");
+    while(n > 0) {
+        ssize_t w = pwrite(fd, datos, n, pos);
+        if(w < 0 && errno == EINTR) continue;
+        if(w <= 0) return false;
+        datos += w;
+        n -= (size_t)w;
+        pos += w;
+    }
+    return true;
+}
+
+// Constructor
+DecodificadorLote::DecodificadorLote(const ConfigLote& cfg)
+    : config(cfg), tabla(&rotor), pool(nullptr), cache(nullptr), archivos(nullptr),
+      numArchivos(0), grupos(nullptr), numGrupos(0) {}
+
+// Destructor
+DecodificadorLote::~DecodificadorLote() {
+    delete cache;
+    for(int i = 0; i < numArchivos; i++) {
+        delete[] archivos[i].ruta;
+        delete[] archivos[i].salida;
+        delete[] archivos[i].trozos;
+    }
+    for(int i = 0; i < numGrupos; i++) delete[] grupos[i].archivos;
+    delete[] archivos;
+    delete[] grupos;
+}
+
+// Juntar rutas: todos los archivos regulares del directorio, o las líneas de la lista
+bool DecodificadorLote::listarEntradas() {
+    struct stat st;
+    if(stat(config.entrada, &st) != 0) {
+        std::cerr << "[ERROR] No existe " << config.entrada << std::endl;
+        return false;
+    }
+    
+    int capacidad = 64;
+    char** rutas = new char*[capacidad];
+    int n = 0;
+    char ruta[4096];
+    
+    if(S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(config.entrada);
+        if(!dir) {
+            std::cerr << "[ERROR] No se pudo abrir " << config.entrada << std::endl;
+            delete[] rutas;
+            return false;
+        }
+        for(struct dirent* e = readdir(dir); e; e = readdir(dir)) {
+            if(e->d_name[0] == '.') continue;
+            snprintf(ruta, sizeof(ruta), "%s/%s", config.entrada, e->d_name);
+            struct stat sa;
+            if(stat(ruta, &sa) != 0 || !S_ISREG(sa.st_mode)) continue;
+            
+            if(n == capacidad) {
+                char** mayor = new char*[capacidad * 2];
+                memcpy(mayor, rutas, sizeof(char*) * n);
+                delete[] rutas;
+                rutas = mayor;
+                capacidad *= 2;
+            }
+            rutas[n++] = duplicar(ruta);
+        }
+        closedir(dir);
+    } else {
+        FILE* lista = fopen(config.entrada, "r");
+        if(!lista) {
+            std::cerr << "[ERROR] No se pudo abrir " << config.entrada << std::endl;
+            delete[] rutas;
+            return false;
+        }
+        while(fgets(ruta, sizeof(ruta), lista)) {
+            size_t largo = strcspn(ruta, "\r\n");
+            ruta[largo] = '\0';
+            if(largo == 0 || ruta[0] == '#') continue;
+            
+            if(n == capacidad) {
+                char** mayor = new char*[capacidad * 2];
+                memcpy(mayor, rutas, sizeof(char*) * n);
+                delete[] rutas;
+                rutas = mayor;
+                capacidad *= 2;
+            }
+            rutas[n++] = duplicar(ruta);
+        }
+        fclose(lista);
+    }
+    
+    archivos = new ArchivoLote[n > 0 ? n : 1];
+    numArchivos = n;
+    for(int i = 0; i < n; i++) {
+        ArchivoLote& a = archivos[i];
+        a.ruta = rutas[i];
+        
+        // Resultado: <dirSalida>/<nombre de la captura>.txt; en una lista
+        // dos capturas pueden llamarse igual, y entonces la segunda lleva
+        // su posición: <nombre>.<i>.txt (el manifiesto dice cuál es cuál)
+        const char* base = strrchr(a.ruta, '/');
+        base = base ? base + 1 : a.ruta;
+        snprintf(ruta, sizeof(ruta), "%s/%s.txt", config.dirSalida, base);
+        if(salidaRepetida(ruta, i)) {
+            snprintf(ruta, sizeof(ruta), "%s/%s.%d.txt", config.dirSalida, base, i);
+            if(salidaRepetida(ruta, i)) {
+                std::cerr << "[ERROR] Dos capturas escribirían en " << ruta << std::endl;
+                for(int j = i; j < n; j++) delete[] rutas[j];
+                delete[] rutas;
+                numArchivos = i;
+                return false;
+            }
+        }
+        a.salida = duplicar(ruta);
+        
+        struct stat sa;
+        a.bytes = stat(a.ruta, &sa) == 0 ? (size_t)sa.st_size : 0;
+        a.datos = nullptr;
+        a.numTrozos = 0;
+        a.trozos = nullptr;
+        a.restantes = 0;
+        a.fdSalida = -1;
+        a.tramas = a.malformadas = 0;
+        a.caracteres = 0;
+        a.inicioNs = 0;
+        a.finNs = 0;
+        a.error = false;
+        a.estadoCache = '-';
+        a.lote = this;
+    }
+    delete[] rutas;
+    return true;
+}
+
+// ¿Alguna de las primeras n capturas ya escribe en esta ruta?
+bool DecodificadorLote::salidaRepetida(const char* salida, int n) const {
+    for(int i = 0; i < n; i++) {
+        if(strcmp(archivos[i].salida, salida) == 0) return true;
+    }
+    return false;
+}
+
+// Mapear una captura grande y cortarla en límites de línea
+bool DecodificadorLote::partir(ArchivoLote& a) {
+    int fd = open(a.ruta, O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return false;
+    void* p = mmap(nullptr, a.bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED) return false;
+    
+    a.datos = (const char*)p;
+    madvise(p, a.bytes, MADV_SEQUENTIAL);
+    
+    int maxTrozos = (int)(a.bytes / TAM_TROZO) + 1;
+    a.trozos = new TrozoLote[maxTrozos];
+    
+    size_t desde = 0;
+    while(desde < a.bytes) {
+        size_t hasta = desde + TAM_TROZO;
+        if(hasta >= a.bytes) {
+            hasta = a.bytes;
+        } else {
+            // Avanzar hasta pasar un fin de línea
+            while(hasta < a.bytes && a.datos[hasta - 1] != '\n' && a.datos[hasta - 1] != '\r') hasta++;
+        }
+        
+        TrozoLote& t = a.trozos[a.numTrozos++];
+        t.archivo = &a;
+        t.desde = desde;
+        t.hasta = hasta;
+        t.crudos = nullptr;
+        t.relativos = nullptr;
+        t.cargas = t.capacidad = 0;
+        t.rotacion = 0;
+        t.inicioSalida = t.desplazamiento = 0;
+        t.tramas = t.malformadas = 0;
+        desde = hasta;
+    }
+    return true;
+}
+
+// Capturas pequeñas: cada una con su propia sesión (rotor y lista)
+void DecodificadorLote::tareaGrupo(void* arg) {
+    GrupoLote* g = (GrupoLote*)arg;
+    
+    for(int i = 0; i < g->cantidad; i++) {
+        ArchivoLote& a = *g->archivos[i];
+        DecodificadorLote* lote = a.lote;
+        a.inicioNs = ahoraNs();
+        
+        // Leer la captura completa (es pequeña): hace falta para la clave
+        int fd = open(a.ruta, O_RDONLY | O_CLOEXEC);
+        char* datos = new char[a.bytes > 0 ? a.bytes : 1];
+        size_t leidos = 0;
+        if(fd >= 0) {
+            ssize_t n;
+            while(leidos < a.bytes && (n = read(fd, datos + leidos, a.bytes - leidos)) > 0) {
+                leidos += (size_t)n;
+            }
+            close(fd);
+        }
+        int fdSalida = fd >= 0 && leidos == a.bytes
+                       ? open(a.salida, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : -1;
+        if(fdSalida < 0) {
+            a.error = true;
+            delete[] datos;
+            a.finNs = ahoraNs();
+            continue;
+        }
+        
+        if(lote->cache) {
+            a.clave = lote->cache->clave(datos, a.bytes);
+            EntradaCache e;
+            if(lote->cache->buscar(a.clave, e, fdSalida)) {
+                a.estadoCache = 'A';
+                a.tramas = e.tramas;
+                a.malformadas = e.malformadas;
+                a.caracteres = e.caracteres;
+                close(fdSalida);
+                delete[] datos;
+                a.finNs = ahoraNs();
+                continue;
+            }
+            a.estadoCache = 'F';
+            if(ftruncate(fdSalida, 0) != 0) a.error = true;
+        }
+        
+        SesionDecodificador sesion;
+        sesion.configurar(lote->config.desplazamiento, lote->config.estricto);
+        sesion.alimentar(datos, (int)a.bytes);
+        sesion.finalizar();
+        delete[] datos;
+        
+        a.tramas = sesion.getTramas();
+        a.malformadas = sesion.getMalformadas();
+        a.caracteres = sesion.getCarga().getLongitud();
+        
+        char* mensaje = new char[a.caracteres > 0 ? a.caracteres : 1];
+        int copiados = sesion.getCarga().copiarMensaje(mensaje, (int)a.caracteres);
+        if(!escribirEn(fdSalida, mensaje, (size_t)copiados, 0)) a.error = true;
+        close(fdSalida);
+        
+        if(lote->cache && !a.error) {
+            EntradaCache e = { a.tramas, a.malformadas, a.caracteres };
+            lote->cache->guardar(a.clave, e, mensaje);
+        }
+        delete[] mensaje;
+        a.finNs = ahoraNs();
+    }
+}
+
+// Captura grande con caché: acierto directo o partir en trozos
+void DecodificadorLote::tareaHuella(void* arg) {
+    ArchivoLote& a = *(ArchivoLote*)arg;
+    DecodificadorLote* lote = a.lote;
+    a.inicioNs = ahoraNs();
+    a.clave = lote->cache->clave(a.datos, a.bytes);
+    
+    int fdSalida = open(a.salida, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    EntradaCache e;
+    if(fdSalida >= 0 && lote->cache->buscar(a.clave, e, fdSalida)) {
+        close(fdSalida);
+        a.estadoCache = 'A';
+        a.tramas = e.tramas;
+        a.malformadas = e.malformadas;
+        a.caracteres = e.caracteres;
+        cerrarArchivo(a);
+        return;
+    }
+    if(fdSalida >= 0) close(fdSalida);
+    
+    a.estadoCache = 'F';
+    lote->explorar(a);
+}
+
+// Fase 1 de todos los trozos
+void DecodificadorLote::explorar(ArchivoLote& a) {
+    a.restantes = a.numTrozos;
+    for(int k = 0; k < a.numTrozos; k++) pool->enviar(tareaExplorar, &a.trozos[k]);
+}
+
+// Fase 1: cargas crudas y rotaciones relativas del trozo
+void DecodificadorLote::tareaExplorar(void* arg) {
+    TrozoLote* t = (TrozoLote*)arg;
+    TRAZA_INTERVALO("explorar");
+    ArchivoLote& a = *t->archivo;
+    const TablaMapeo& tabla = a.lote->tabla;
+    
+    long long inicio = ahoraNs();
+    long long vacio = 0;
+    a.inicioNs.compare_exchange_strong(vacio, inicio);
+    
+    // Una carga L ocupa al menos 3 bytes ("L,X"); las tramas B la hacen crecer
+    t->capacidad = (long)((t->hasta - t->desde) / 3) + 2;
+    t->crudos = new char[t->capacidad];
+    t->relativos = new unsigned char[t->capacidad];
+    
+    // Mismo armado de líneas que SesionDecodificador
+    const int LARGO_LINEA = LARGO_MAX_LINEA;
+    char linea[LARGO_LINEA];
+    int largo = 0;
+    bool desbordada = false;
+    long acumulado = 0;
+    
+    for(size_t i = t->desde; i <= t->hasta; i++) {
+        bool finLinea = (i == t->hasta) || a.datos[i] == '\n' || a.datos[i] == '\r';
+        if(!finLinea) {
+            if(largo < LARGO_LINEA - 1) {
+                linea[largo++] = a.datos[i];
+            } else {
+                desbordada = true;
+            }
+            continue;
+        }
+        if(largo == 0 && !desbordada) continue;
+        
+        linea[largo] = '\0';
+        TramaBase* trama = desbordada ? nullptr : parsearTrama(linea, a.lote->config.estricto);
+        largo = 0;
+        desbordada = false;
+        
+        if(!trama) {
+            t->malformadas++;
+            continue;
+        }
+        t->tramas++;
+        
+        if(trama->getTipo() == 'L') {
+            asegurarCapacidad(t, 1);
+            t->crudos[t->cargas] = static_cast<TramaLoad*>(trama)->getCaracter();
+            t->relativos[t->cargas] = (unsigned char)tabla.normalizar(acumulado);
+            t->cargas++;
+        } else if(trama->getTipo() == 'B') {
+            // Toda la carga comparte la rotación del momento
+            TramaCargaMasiva* masiva = static_cast<TramaCargaMasiva*>(trama);
+            int n = masiva->getLargo();
+            asegurarCapacidad(t, n);
+            memcpy(t->crudos + t->cargas, masiva->getCarga(), n);
+            memset(t->relativos + t->cargas, tabla.normalizar(acumulado), n);
+            t->cargas += n;
+        } else {
+            acumulado += static_cast<TramaMap*>(trama)->getRotacion();
+        }
+        delete trama;
+    }
+    t->rotacion = acumulado;
+    
+    // El último trozo en terminar combina los resultados de la captura
+    if(--a.restantes == 0) a.lote->combinar(a);
+}
+
+// Fase 2: prefijos de rotación y de salida, luego la fase 3
+void DecodificadorLote::combinar(ArchivoLote& a) {
+    long desplazamiento = tabla.normalizar(config.desplazamiento);
+    long posicion = 0;
+    for(int k = 0; k < a.numTrozos; k++) {
+        TrozoLote& t = a.trozos[k];
+        t.desplazamiento = desplazamiento;
+        t.inicioSalida = posicion;
+        desplazamiento = tabla.normalizar(desplazamiento + t.rotacion);
+        posicion += t.cargas;
+        a.tramas += t.tramas;
+        a.malformadas += t.malformadas;
+    }
+    a.caracteres = posicion;
+    
+    a.fdSalida = open(a.salida, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(a.fdSalida < 0 || ftruncate(a.fdSalida, (off_t)posicion) != 0) {
+        a.error = true;
+        for(int k = 0; k < a.numTrozos; k++) {
+            delete[] a.trozos[k].crudos;
+            delete[] a.trozos[k].relativos;
+        }
+        cerrarArchivo(a);
+        return;
+    }
+    
+    a.restantes = a.numTrozos;
+    for(int k = 0; k < a.numTrozos; k++) pool->enviar(tareaMapear, &a.trozos[k]);
+}
+
+// Fase 3: mapear con el desplazamiento ya conocido y escribir el tramo
+void DecodificadorLote::tareaMapear(void* arg) {
+    TrozoLote* t = (TrozoLote*)arg;
+    TRAZA_INTERVALO("mapear");
+    ArchivoLote& a = *t->archivo;
+    const TablaMapeo& tabla = a.lote->tabla;
+    
+    // Los crudos ya no se usan: el resultado se escribe en su lugar
+    char* salida = t->crudos;
+    for(long i = 0; i < t->cargas; i++) {
+        salida[i] = tabla.tabla(tabla.normalizar(t->desplazamiento + t->relativos[i]))
+                                [(unsigned char)t->crudos[i]];
+    }
+    
+    if(!escribirEn(a.fdSalida, salida, (size_t)t->cargas, (off_t)t->inicioSalida)) {
+        a.error = true;
+    }
+    delete[] t->crudos;
+    delete[] t->relativos;
+    t->crudos = nullptr;
+    t->relativos = nullptr;
+    
+    if(--a.restantes == 0) {
+        // El resultado completo está en el archivo: guardarlo en la caché
+        if(a.lote->cache && !a.error && a.caracteres > 0) {
+            void* m = mmap(nullptr, (size_t)a.caracteres, PROT_READ, MAP_SHARED, a.fdSalida, 0);
+            if(m != MAP_FAILED) {
+                EntradaCache e = { a.tramas, a.malformadas, a.caracteres };
+                a.lote->cache->guardar(a.clave, e, (const char*)m);
+                munmap(m, (size_t)a.caracteres);
+            }
+        }
+        close(a.fdSalida);
+        a.fdSalida = -1;
+        cerrarArchivo(a);
+    }
+}
+
+// Fin de una captura grande
+void DecodificadorLote::cerrarArchivo(ArchivoLote& a) {
+    if(a.datos) munmap((void*)a.datos, a.bytes);
+    a.datos = nullptr;
+    a.finNs = ahoraNs();
+}
+
+// Ejecutar el lote completo
+bool DecodificadorLote::ejecutar() {
+    if(!listarEntradas()) return false;
+    if(numArchivos == 0) {
+        std::cerr << "[ERROR] No hay capturas en " << config.entrada << std::endl;
+        return false;
+    }
+    if(mkdir(config.dirSalida, 0755) != 0 && errno != EEXIST) {
+        std::cerr << "[ERROR] No se pudo crear " << config.dirSalida << ": "
+                  << strerror(errno) << std::endl;
+        return false;
+    }
+    
+    long long inicio = ahoraNs();
+    
+    // Repartir: grandes en trozos, pequeñas en grupos de ~TAM_GRUPO bytes
+    grupos = new GrupoLote[numArchivos];
+    GrupoLote* actual = nullptr;
+    size_t bytesGrupo = 0;
+    
+    for(int i = 0; i < numArchivos; i++) {
+        ArchivoLote& a = archivos[i];
+        if(a.bytes >= UMBRAL_GRANDE && partir(a)) continue;
+        
+        if(!actual || bytesGrupo >= TAM_GRUPO) {
+            actual = &grupos[numGrupos++];
+            actual->archivos = new ArchivoLote*[numArchivos - i];
+            actual->cantidad = 0;
+            bytesGrupo = 0;
+        }
+        actual->archivos[actual->cantidad++] = &a;
+        bytesGrupo += a.bytes;
+    }
+    
+    if(config.dirCache) {
+        cache = new CacheDecodificacion(config.dirCache, config.maxCache, tabla,
+                                        config.desplazamiento, config.estricto);
+        if(!cache->estaLista()) {
+            delete cache;
+            cache = nullptr;
+        }
+    }
+    
+    PoolTrabajo trabajo(config.hilos);
+    pool = &trabajo;
+    
+    // Primero las grandes: las tareas más antiguas son las que se roban
+    for(int i = 0; i < numArchivos; i++) {
+        ArchivoLote& a = archivos[i];
+        if(a.numTrozos == 0) continue;
+        if(cache) {
+            trabajo.enviar(tareaHuella, &a);
+        } else {
+            explorar(a);
+        }
+    }
+    for(int g = 0; g < numGrupos; g++) trabajo.enviar(tareaGrupo, &grupos[g]);
+    
+    trabajo.esperar();
+    long long total = ahoraNs() - inicio;
+    
+    unsigned long robadas = 0;
+    for(int h = 0; h < trabajo.getNumHilos(); h++) robadas += trabajo.getRobadas(h);
+    pool = nullptr;
+    
+    escribirManifiesto(total);
+    
+    size_t bytes = 0;
+    unsigned long tramas = 0;
+    int errores = 0;
+    for(int i = 0; i < numArchivos; i++) {
+        bytes += archivos[i].bytes;
+        tramas += archivos[i].tramas;
+        if(archivos[i].error) errores++;
+    }
+    double segundos = total / 1e9;
+    std::cout << "[LOTE] " << numArchivos << " capturas (" << numGrupos << " grupos), "
+              << bytes / (1024.0 * 1024.0) << " MB, " << tramas << " tramas en "
+              << segundos << " s (" << bytes / (1024.0 * 1024.0) / (segundos > 0 ? segundos : 1e-9)
+              << " MB/s) con " << trabajo.getNumHilos() << " hilos, "
+              << robadas << " tareas robadas" << std::endl;
+    if(cache) {
+        std::cout << "[LOTE] Caché " << config.dirCache << ": " << cache->getAciertos()
+                  << " aciertos, " << cache->getFallos() << " fallos" << std::endl;
+    }
+    if(errores > 0) {
+        std::cerr << "[ERROR] " << errores << " capturas con errores (ver manifiesto)" << std::endl;
+    }
+    return errores == 0;
+}
+
+// Manifiesto: una fila por captura
+void DecodificadorLote::escribirManifiesto(long long totalNs) {
+    char ruta[4096];
+    snprintf(ruta, sizeof(ruta), "%s/manifiesto.tsv", config.dirSalida);
+    FILE* f = fopen(ruta, "w");
+    if(!f) {
+        std::cerr << "[ERROR] No se pudo escribir " << ruta << std::endl;
+        return;
+    }
+    
+    fprintf(f, "# captura\tbytes\ttramas\tmalformadas\tcaracteres\ttrozos\tms\testado\tcache\tresultado\n");
+    for(int i = 0; i < numArchivos; i++) {
+        ArchivoLote& a = archivos[i];
+        const char* usoCache = a.estadoCache == 'A' ? "acierto" : (a.estadoCache == 'F' ? "fallo" : "-");
+        fprintf(f, "%s\t%zu\t%lu\t%lu\t%ld\t%d\t%.3f\t%s\t%s\t%s\n",
+                a.ruta, a.bytes, a.tramas, a.malformadas, a.caracteres,
+                a.numTrozos > 0 ? a.numTrozos : 1, (a.finNs - a.inicioNs.load()) / 1e6,
+                a.error ? "ERROR" : "OK", usoCache, a.salida);
+    }
+    fprintf(f, "# total\t%d capturas\t%.3f ms\n", numArchivos, totalNs / 1e6);
+    fclose(f);
+    
+    std::cout << "[INFO] Manifiesto en " << ruta << std::endl;
+}
+
+#else
+// ===== WINDOWS: sin mmap ni dirent =====
+
+struct ArchivoLote {};
+struct GrupoLote {};
+
+DecodificadorLote::DecodificadorLote(const ConfigLote& cfg)
+    : config(cfg), tabla(&rotor), pool(nullptr), cache(nullptr), archivos(nullptr),
+      numArchivos(0), grupos(nullptr), numGrupos(0) {}
+DecodificadorLote::~DecodificadorLote() {}
+
+bool DecodificadorLote::ejecutar() {
+    std::cerr << "El modo lote sólo está disponible en sistemas POSIX" << std::endl;
+    return false;
+}
+
+#endif // _WIN32
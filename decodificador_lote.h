@@ -0,0 +1,137 @@
+// ============================================================================
+// DecodificadorLote.h - Decodificación en Lote de Capturas Grabadas
+// ============================================================================
+
+#ifndef DECODIFICADOR_LOTE_H
+#define DECODIFICADOR_LOTE_H
+
+#include <cstddef>
+#include "RotorDeMapeo.h"
+#include "TablaMapeo.h"
+#include "PoolTrabajo.h"
+#include "CacheDecodificacion.h"
+
+/**
+ * @struct ConfigLote
+ * @brief Parámetros del modo lote
+ */
+struct ConfigLote {
+    const char* entrada;    ///< Directorio de capturas o archivo con una ruta por línea
+    const char* dirSalida;  ///< Directorio para los resultados y el manifiesto
+    int hilos;              ///< Trabajadores (0 = uno por núcleo)
+    int desplazamiento;     ///< Rotación inicial del rotor
+    bool estricto;          ///< Parser en modo estricto
+    const char* dirCache;   ///< Caché de resultados (nullptr = sin caché)
+    long long maxCache;     ///< Bytes máximos de la caché
+};
+
+struct ArchivoLote;
+struct TrozoLote;
+struct GrupoLote;
+
+/**
+ * @class DecodificadorLote
+ * @brief Decodifica muchas capturas en un mismo proceso sobre un PoolTrabajo
+ * 
+ * Cada captura se decodifica con su propio estado de rotor y carga, y el
+ * resultado va a <dirSalida>/<nombre>.txt (<nombre>.<i>.txt si otra
+ * captura de la lista ya tiene ese nombre). Para que el rendimiento escale
+ * con los núcleos aunque los tamaños sean muy desparejos:
+ * - Las capturas pequeñas se agrupan en una tarea (se decodifican con una
+ *   SesionDecodificador cada una) para no pagar una tarea por archivo.
+ * - Las grandes se parten en trozos en límites de línea y se decodifican
+ *   en tres fases: (1) en paralelo, cada trozo guarda sus cargas crudas,
+ *   la rotación acumulada antes de cada una y su rotación neta; (2) la
+ *   última en terminar suma en prefijo las rotaciones netas para conocer
+ *   el desplazamiento inicial de cada trozo; (3) en paralelo, cada trozo
+ *   mapea sus cargas con la TablaMapeo y escribe su tramo de la salida.
+ * 
+ * Con dirCache, cada captura se busca primero en una CacheDecodificacion
+ * (por el hash de su contenido y la configuración) y sólo se decodifica
+ * si no está; las capturas grandes se hashean en una tarea propia antes
+ * de partirse.
+ * 
+ * Al terminar se escribe <dirSalida>/manifiesto.tsv con una fila por
+ * captura (tramas, caracteres, trozos, tiempo y uso de la caché). Sólo
+ * disponible en POSIX.
+ */
+class DecodificadorLote {
+private:
+    static const size_t UMBRAL_GRANDE = 4 << 20;    ///< Desde aquí la captura se parte
+    static const size_t TAM_TROZO = 1 << 20;        ///< Bytes por trozo de una captura grande
+    static const size_t TAM_GRUPO = 1 << 20;        ///< Bytes por grupo de capturas pequeñas
+    
+    ConfigLote config;          ///< Parámetros
+    RotorDeMapeo rotor;         ///< Rotor inicial (sólo para construir la tabla)
+    TablaMapeo tabla;           ///< Mapeo por desplazamiento, compartido y de sólo lectura
+    PoolTrabajo* pool;          ///< Trabajadores (durante ejecutar())
+    CacheDecodificacion* cache; ///< Caché de resultados (o nullptr)
+    
+    ArchivoLote* archivos;      ///< Una entrada por captura
+    int numArchivos;            ///< Cantidad de capturas
+    GrupoLote* grupos;          ///< Grupos de capturas pequeñas
+    int numGrupos;              ///< Cantidad de grupos
+    
+    /**
+     * @brief Junta las rutas de la entrada (directorio o lista)
+     */
+    bool listarEntradas();
+    
+    /**
+     * @brief Indica si alguna de las primeras n capturas ya usa esa salida
+     */
+    bool salidaRepetida(const char* salida, int n) const;
+    
+    /**
+     * @brief Mapea una captura grande y la parte en trozos
+     */
+    bool partir(ArchivoLote& a);
+    
+    /**
+     * @brief Escribe el manifiesto y el resumen
+     */
+    void escribirManifiesto(long long totalNs);
+    
+    static void tareaGrupo(void* arg);      ///< Capturas pequeñas, completas
+    static void tareaHuella(void* arg);     ///< Captura grande: buscar en la caché
+    static void tareaExplorar(void* arg);   ///< Fase 1 de un trozo
+    static void tareaMapear(void* arg);     ///< Fase 3 de un trozo
+    
+    /**
+     * @brief Fase 2: desplazamientos iniciales y envío de la fase 3
+     */
+    void combinar(ArchivoLote& a);
+    
+    /**
+     * @brief Envía la fase 1 de todos los trozos de una captura grande
+     */
+    void explorar(ArchivoLote& a);
+    
+    /**
+     * @brief Marca una captura como terminada y libera su entrada
+     */
+    static void cerrarArchivo(ArchivoLote& a);
+
+public:
+    /**
+     * @brief Constructor
+     * @param cfg Parámetros del lote
+     */
+    explicit DecodificadorLote(const ConfigLote& cfg);
+    
+    /**
+     * @brief Destructor - Libera las capturas y los grupos
+     */
+    ~DecodificadorLote();
+    
+    DecodificadorLote(const DecodificadorLote&) = delete;
+    DecodificadorLote& operator=(const DecodificadorLote&) = delete;
+    
+    /**
+     * @brief Decodifica todas las capturas
+     * @return true si todas se decodificaron y escribieron
+     */
+    bool ejecutar();
+};
+
+#endif // DECODIFICADOR_LOTE_H
@@ -0,0 +1,240 @@
+// ============================================================================
+// DecodificadorRetroactivo.cpp - Implementación de Correcciones Tardías
+// ============================================================================
+
+#include "DecodificadorRetroactivo.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+#include <iostream>
+#include <cstring>
+
+// Copia un arreglo a uno más grande, rellenando con ceros
+template <typename T>
+static T* crecerArreglo(T* viejo, unsigned long usados, unsigned long nuevaCap) {
+    T* nuevo = new T[nuevaCap];
+    if(viejo) memcpy(nuevo, viejo, usados * sizeof(T));
+    memset(nuevo + usados, 0, (nuevaCap - usados) * sizeof(T));
+    delete[] viejo;
+    return nuevo;
+}
+
+// Constructor
+DecodificadorRetroactivo::DecodificadorRetroactivo(ListaDeCarga* carga, RotorDeMapeo* rotor)
+    : carga(carga), rotor(rotor), tabla(rotor),
+      crudo(nullptr), posCarga(nullptr), delta(nullptr), arbol(nullptr),
+      numCargas(0), capCargas(0), valorMapa(nullptr), capMapas(0), base(0),
+      iniciado(false), deltaPendiente(0), sumaTotal(0), siguientePos(0), aplicadas(0),
+      correcciones(0), redecodificados(0), descartadas(0) {}
+
+// Destructor
+DecodificadorRetroactivo::~DecodificadorRetroactivo() {
+    delete[] crudo;
+    delete[] posCarga;
+    delete[] delta;
+    delete[] arbol;
+    delete[] valorMapa;
+}
+
+// Aplicar trama según su tipo
+void DecodificadorRetroactivo::aplicar(TramaBase* trama) {
+    unsigned long pos = trama->tieneSecuencia() ? trama->getSecuencia() : siguientePos;
+    
+    if(!iniciado) {
+        base = pos;
+        iniciado = true;
+    }
+    if(pos < base) {
+        siguientePos = pos + 1;
+        descartadas++;
+        return;
+    }
+    if(fueraDeAlcance(pos)) {
+        descartadas++;
+        std::cout << "[WARN] Secuencia " << pos << " fuera de alcance, trama descartada" << std::endl;
+        return;
+    }
+    siguientePos = pos + 1;
+    aplicadas++;
+    
+    if(trama->getTipo() == 'L') {
+        TramaLoad* t = static_cast<TramaLoad*>(trama);
+        if(!cargar(pos, t->getCaracter())) {
+            descartadas++;
+            std::cout << "[WARN] Carga tardía en posición " << pos << " descartada" << std::endl;
+        }
+    } else if(trama->getTipo() == 'B') {
+        TramaCargaMasiva* t = static_cast<TramaCargaMasiva*>(trama);
+        if(!cargarBloque(pos, t->getCarga(), t->getLargo())) {
+            descartadas++;
+            std::cout << "[WARN] Carga tardía en posición " << pos << " descartada" << std::endl;
+        }
+    } else if(trama->getTipo() == 'M') {
+        TramaMap* t = static_cast<TramaMap*>(trama);
+        bool tardio = numCargas > 0 && pos < posCarga[numCargas - 1];
+        int anterior = (pos - base < capMapas) ? valorMapa[pos - base] : 0;
+        int n = fijarMapa(pos, t->getRotacion());
+        if(tardio) {
+            std::cout << "[CORRECCION] MAP en posición " << pos << ": "
+                      << anterior << " -> " << t->getRotacion() << ", "
+                      << n << " caracteres re-decodificados" << std::endl;
+        }
+    }
+}
+
+// Nueva carga al final
+bool DecodificadorRetroactivo::cargar(unsigned long pos, char c) {
+    if(numCargas > 0 && pos <= posCarga[numCargas - 1]) return false;
+    if(pos - base < capMapas && valorMapa[pos - base] != 0) return false;
+    
+    crecerCargas();
+    int i = numCargas++;
+    crudo[i] = c;
+    posCarga[i] = pos;
+    delta[i] = (int)deltaPendiente;
+    sumarArbol(i, delta[i]);
+    sumaTotal += deltaPendiente;
+    deltaPendiente = 0;
+    
+    carga->insertarAlFinal(tabla.mapear(sumaTotal, c));
+    return true;
+}
+
+// Nueva carga masiva al final: una posición, varios caracteres
+bool DecodificadorRetroactivo::cargarBloque(unsigned long pos, const char* datos, int n) {
+    if(numCargas > 0 && pos <= posCarga[numCargas - 1]) return false;
+    if(pos - base < capMapas && valorMapa[pos - base] != 0) return false;
+    if(n <= 0) return true;
+    
+    // Sólo el primer carácter arrastra los MAP previos; el resto tiene delta 0
+    int primera = numCargas;
+    for(int k = 0; k < n; k++) {
+        crecerCargas();
+        int i = numCargas++;
+        crudo[i] = datos[k];
+        posCarga[i] = pos;
+        delta[i] = 0;
+    }
+    delta[primera] = (int)deltaPendiente;
+    sumarArbol(primera, delta[primera]);
+    sumaTotal += deltaPendiente;
+    deltaPendiente = 0;
+    
+    char decodificado[TramaCargaMasiva::MAX_CARGA];
+    const char* t = tabla.tabla(tabla.normalizar(sumaTotal));
+    int hecho = 0;
+    while(hecho < n) {
+        int m = n - hecho < TramaCargaMasiva::MAX_CARGA ? n - hecho : TramaCargaMasiva::MAX_CARGA;
+        for(int k = 0; k < m; k++) decodificado[k] = t[(unsigned char)datos[hecho + k]];
+        carga->insertarBloque(decodificado, m);
+        hecho += m;
+    }
+    return true;
+}
+
+// Insertar/cambiar/quitar un MAP
+int DecodificadorRetroactivo::fijarMapa(unsigned long pos, int valor) {
+    if(pos < base || fueraDeAlcance(pos)) return 0;
+    crecerMapas(pos - base);
+    
+    int d = valor - valorMapa[pos - base];
+    valorMapa[pos - base] = valor;
+    if(d == 0) return 0;
+    
+    // El rotor vivo refleja siempre la rotación total corregida
+    rotor->rotar(d);
+    
+    int j = primeraCargaDespuesDe(pos);
+    if(j == numCargas) {
+        // Ninguna carga afectada todavía
+        deltaPendiente += d;
+        return 0;
+    }
+    
+    correcciones++;
+    delta[j] += d;
+    sumarArbol(j, d);
+    sumaTotal += d;
+    
+    // Re-decodificar sólo el sufijo [j, numCargas)
+    int cantidad = numCargas - j;
+    char* nuevos = new char[cantidad];
+    long desp = prefijo(j);
+    for(int k = 0; k < cantidad; k++) {
+        if(k > 0) desp += delta[j + k];
+        nuevos[k] = tabla.mapear(desp, crudo[j + k]);
+    }
+    carga->reescribirSufijo(cantidad, nuevos);
+    delete[] nuevos;
+    
+    redecodificados += cantidad;
+    return cantidad;
+}
+
+// Quitar un MAP
+int DecodificadorRetroactivo::eliminarMapa(unsigned long pos) {
+    return fijarMapa(pos, 0);
+}
+
+// Carácter decodificado de una carga
+char DecodificadorRetroactivo::decodificadoEn(int i) const {
+    if(i < 0 || i >= numCargas) return '\0';
+    return tabla.mapear(prefijo(i), crudo[i]);
+}
+
+// Fenwick: suma puntual
+void DecodificadorRetroactivo::sumarArbol(int i, int d) {
+    for(int k = i + 1; k <= capCargas; k += k & (-k)) {
+        arbol[k] += d;
+    }
+}
+
+// Fenwick: suma de delta[0..i]
+long DecodificadorRetroactivo::prefijo(int i) const {
+    long s = 0;
+    for(int k = i + 1; k > 0; k -= k & (-k)) {
+        s += arbol[k];
+    }
+    return s;
+}
+
+// Búsqueda binaria sobre las posiciones de carga
+int DecodificadorRetroactivo::primeraCargaDespuesDe(unsigned long pos) const {
+    int lo = 0, hi = numCargas;
+    while(lo < hi) {
+        int mid = (lo + hi) / 2;
+        if(posCarga[mid] > pos) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+// Crecer arreglos de cargas (el árbol se reconstruye en O(n))
+void DecodificadorRetroactivo::crecerCargas() {
+    if(numCargas < capCargas) return;
+    
+    int nuevaCap = capCargas ? capCargas * 2 : 1024;
+    crudo = crecerArreglo(crudo, numCargas, nuevaCap);
+    posCarga = crecerArreglo(posCarga, numCargas, nuevaCap);
+    delta = crecerArreglo(delta, numCargas, nuevaCap);
+    
+    delete[] arbol;
+    arbol = new int[nuevaCap + 1];
+    memset(arbol, 0, (nuevaCap + 1) * sizeof(int));
+    capCargas = nuevaCap;
+    for(int k = 1; k <= capCargas; k++) {
+        arbol[k] += delta[k - 1];
+        int padre = k + (k & (-k));
+        if(padre <= capCargas) arbol[padre] += arbol[k];
+    }
+}
+
+// Crecer arreglo de MAP por posición
+void DecodificadorRetroactivo::crecerMapas(unsigned long indice) {
+    if(indice < capMapas) return;
+    
+    unsigned long nuevaCap = capMapas ? capMapas : 1024;
+    while(nuevaCap <= indice) nuevaCap *= 2;
+    valorMapa = crecerArreglo(valorMapa, capMapas, nuevaCap);
+    capMapas = nuevaCap;
+}
@@ -0,0 +1,165 @@
+// ============================================================================
+// DecodificadorRetroactivo.h - Correcciones Tardías de Tramas MAP
+// ============================================================================
+
+#ifndef DECODIFICADOR_RETROACTIVO_H
+#define DECODIFICADOR_RETROACTIVO_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "TablaMapeo.h"
+
+/**
+ * @class DecodificadorRetroactivo
+ * @brief Decodificador que admite MAP insertados, cambiados o quitados tarde
+ * 
+ * Cada trama tiene una posición (su número de secuencia, o el orden de
+ * llegada si no lo trae). Los caracteres de una carga masiva (B) comparten
+ * la posición de su trama. Se guardan los caracteres LOAD crudos y, para
+ * cada carga i, la suma de los MAP que caen entre la carga anterior y
+ * ella (delta[i]). Un árbol de Fenwick sobre esos deltas da la rotación
+ * vigente en cualquier carga en O(log n).
+ * 
+ * Un MAP en la posición k afecta sólo al delta de la primera carga
+ * posterior a k; todas las cargas siguientes cambian y se re-decodifican
+ * reescribiendo únicamente ese sufijo de la ListaDeCarga:
+ * O(log n + cantidad de caracteres afectados).
+ * 
+ * valorMapa es denso, así que una posición sólo se acepta si no supera en
+ * más de MAX_SALTO a las tramas aplicadas: un número de secuencia corrupto
+ * se descarta en lugar de pedir gigabytes. La memoria queda proporcional
+ * a la entrada.
+ */
+class DecodificadorRetroactivo {
+private:
+    ListaDeCarga* carga;        ///< Lista con el mensaje decodificado
+    RotorDeMapeo* rotor;        ///< Rotor vivo (se mantiene sincronizado)
+    TablaMapeo tabla;           ///< Mapeo por desplazamiento (relativo al inicio)
+    
+    // Cargas, en orden de posición
+    char* crudo;                ///< Carácter crudo de cada carga
+    unsigned long* posCarga;    ///< Posición de cada carga (creciente)
+    int* delta;                 ///< Rotación de los MAP previos a cada carga
+    int* arbol;                 ///< Árbol de Fenwick sobre delta (base 1)
+    int numCargas;              ///< Cargas recibidas
+    int capCargas;              ///< Capacidad de los arreglos de cargas
+    
+    static const unsigned long MAX_SALTO = 1UL << 16;  ///< Adelanto máximo sobre las tramas aplicadas
+    
+    // MAP, indexados por posición - base
+    int* valorMapa;             ///< Rotación del MAP en cada posición (0 si no hay)
+    unsigned long capMapas;     ///< Capacidad de valorMapa
+    unsigned long base;         ///< Primera posición observada
+    bool iniciado;              ///< true tras la primera trama
+    
+    long deltaPendiente;        ///< MAP posteriores a la última carga
+    long sumaTotal;             ///< Suma de todos los delta de cargas
+    unsigned long siguientePos; ///< Posición para tramas sin secuencia
+    unsigned long aplicadas;    ///< Tramas aceptadas por aplicar()
+    
+    unsigned long correcciones;     ///< MAP aplicados retroactivamente
+    unsigned long redecodificados;  ///< Caracteres reescritos por correcciones
+    unsigned long descartadas;      ///< Tramas tardías o fuera de alcance descartadas
+    
+    /**
+     * @brief Suma en el árbol de Fenwick
+     * @param i Índice de carga (base 0)
+     * @param d Valor a sumar
+     */
+    void sumarArbol(int i, int d);
+    
+    /**
+     * @brief Prefijo del árbol de Fenwick: rotación vigente en la carga i
+     * @param i Índice de carga (base 0)
+     */
+    long prefijo(int i) const;
+    
+    /**
+     * @brief Primera carga con posición estrictamente mayor que pos
+     */
+    int primeraCargaDespuesDe(unsigned long pos) const;
+    
+    /**
+     * @brief Garantiza espacio para una carga más
+     */
+    void crecerCargas();
+    
+    /**
+     * @brief Indica si una posición queda demasiado lejos de lo aplicado
+     */
+    bool fueraDeAlcance(unsigned long pos) const { return pos - base >= aplicadas + MAX_SALTO; }
+    
+    /**
+     * @brief Garantiza que valorMapa cubra el índice dado
+     */
+    void crecerMapas(unsigned long indice);
+
+public:
+    /**
+     * @brief Constructor
+     * @param carga Lista donde se ensambla el mensaje (debe estar vacía)
+     * @param rotor Rotor en su estado inicial
+     */
+    DecodificadorRetroactivo(ListaDeCarga* carga, RotorDeMapeo* rotor);
+    
+    /**
+     * @brief Destructor - Libera los índices (no la lista ni el rotor)
+     */
+    ~DecodificadorRetroactivo();
+    
+    /**
+     * @brief Aplica una trama en su posición
+     * @param trama Trama recibida (no se libera)
+     * 
+     * Un MAP con posición anterior a la última carga se trata como
+     * corrección. Una carga anterior a la última se descarta, igual que
+     * cualquier trama más de MAX_SALTO posiciones por delante.
+     */
+    void aplicar(TramaBase* trama);
+    
+    /**
+     * @brief Agrega una carga al final
+     * @param pos Posición de la trama
+     * @param c Carácter crudo
+     * @return false si la posición no es posterior a la última carga
+     */
+    bool cargar(unsigned long pos, char c);
+    
+    /**
+     * @brief Agrega al final todos los caracteres de una carga masiva
+     * @param pos Posición de la trama
+     * @param datos Caracteres crudos
+     * @param n Cantidad de caracteres
+     * @return false si la posición no es posterior a la última carga
+     */
+    bool cargarBloque(unsigned long pos, const char* datos, int n);
+    
+    /**
+     * @brief Inserta, cambia o quita (valor 0) el MAP de una posición
+     * @param pos Posición de la trama MAP
+     * @param valor Nueva rotación del MAP
+     * @return Cantidad de caracteres re-decodificados (0 si la posición
+     *         está fuera de alcance)
+     */
+    int fijarMapa(unsigned long pos, int valor);
+    
+    /**
+     * @brief Quita el MAP de una posición
+     * @param pos Posición de la trama MAP
+     * @return Cantidad de caracteres re-decodificados
+     */
+    int eliminarMapa(unsigned long pos);
+    
+    /**
+     * @brief Carácter decodificado de la carga i, en O(log n)
+     * @param i Índice de carga (base 0)
+     */
+    char decodificadoEn(int i) const;
+    
+    unsigned long getCorrecciones() const { return correcciones; }         ///< MAP retroactivos
+    unsigned long getRedecodificados() const { return redecodificados; }   ///< Caracteres reescritos
+    unsigned long getDescartadas() const { return descartadas; }           ///< Tramas descartadas
+};
+
+#endif // DECODIFICADOR_RETROACTIVO_H
@@ -0,0 +1,276 @@
+// ============================================================================
+// EstadoPublicado.cpp - Implementación de las Instantáneas con Seqlock
+// ============================================================================
+
+#include "EstadoPublicado.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+// Constructor
+EstadoPublicado::EstadoPublicado(int desplazamientoInicial)
+    : secuencia(0), desplazamiento(desplazamientoInicial), tramas(0), malformadas(0),
+      caracteres(0), abierta(false) {
+    for(int i = 0; i < Instantanea::MAX_COLA; i++) cola[i].store(' ', std::memory_order_relaxed);
+}
+
+// Secuencia impar: los lectores que la vean reintentan
+void EstadoPublicado::abrir() {
+    unsigned long s = secuencia.load(std::memory_order_relaxed);
+    secuencia.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    abierta = true;
+}
+
+// Secuencia par: publica todo lo escrito desde abrir()
+void EstadoPublicado::cerrar() {
+    unsigned long s = secuencia.load(std::memory_order_relaxed);
+    secuencia.store(s + 1, std::memory_order_release);
+    abierta = false;
+}
+
+// Inicio de una trama
+void EstadoPublicado::comenzarTrama() {
+    if(!abierta) abrir();
+}
+
+// Fin de una trama
+void EstadoPublicado::terminarTrama(int desplazamientoRotor) {
+    if(!abierta) abrir();
+    desplazamiento.store(desplazamientoRotor, std::memory_order_relaxed);
+    tramas.store(tramas.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    cerrar();
+}
+
+// Línea rechazada
+void EstadoPublicado::registrarMalformada() {
+    bool propia = !abierta;
+    if(propia) abrir();
+    malformadas.store(malformadas.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if(propia) cerrar();
+}
+
+// Carácter recién insertado
+void EstadoPublicado::alInsertar(char dato, unsigned long) {
+    // Fuera de una trama (ej: al reproducir), cada carácter es su propia sección
+    bool propia = !abierta;
+    if(propia) abrir();
+    unsigned long n = caracteres.load(std::memory_order_relaxed);
+    cola[n & (Instantanea::MAX_COLA - 1)].store(dato, std::memory_order_relaxed);
+    caracteres.store(n + 1, std::memory_order_relaxed);
+    if(propia) cerrar();
+}
+
+// Tramo re-decodificado
+void EstadoPublicado::alReescribir(unsigned long desde, const char* datos, int cantidad) {
+    bool propia = !abierta;
+    if(propia) abrir();
+    unsigned long n = caracteres.load(std::memory_order_relaxed);
+    unsigned long primero = n > (unsigned long)Instantanea::MAX_COLA ? n - Instantanea::MAX_COLA : 0;
+    for(int i = 0; i < cantidad; i++) {
+        unsigned long pos = desde + (unsigned long)i;
+        // Sólo lo que sigue en el anillo; lo anterior ya se descartó
+        if(pos < primero || pos >= n) continue;
+        cola[pos & (Instantanea::MAX_COLA - 1)].store(datos[i], std::memory_order_relaxed);
+    }
+    if(propia) cerrar();
+}
+
+// Copia consistente
+void EstadoPublicado::leer(Instantanea& salida, int maxCola) const {
+    if(maxCola > Instantanea::MAX_COLA) maxCola = Instantanea::MAX_COLA;
+    if(maxCola < 0) maxCola = 0;
+    
+    int intentos = 0;
+    while(true) {
+        unsigned long s1 = secuencia.load(std::memory_order_acquire);
+        if(s1 & 1) {
+            // El escritor está en medio de una trama: es cuestión de nanosegundos
+            if(++intentos > 64) std::this_thread::yield();
+            continue;
+        }
+        
+        salida.desplazamiento = desplazamiento.load(std::memory_order_relaxed);
+        salida.tramas = tramas.load(std::memory_order_relaxed);
+        salida.malformadas = malformadas.load(std::memory_order_relaxed);
+        salida.caracteres = caracteres.load(std::memory_order_relaxed);
+        
+        unsigned long n = salida.caracteres;
+        int largo = n < (unsigned long)maxCola ? (int)n : maxCola;
+        for(int i = 0; i < largo; i++) {
+            unsigned long indice = n - (unsigned long)largo + (unsigned long)i;
+            salida.cola[i] = cola[indice & (Instantanea::MAX_COLA - 1)].load(std::memory_order_relaxed);
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(secuencia.load(std::memory_order_relaxed) == s1) {
+            salida.largoCola = largo;
+            salida.cola[largo] = '\0';
+            return;
+        }
+        if(++intentos > 64) std::this_thread::yield();
+    }
+}
+
+// Texto de una instantánea
+int ServidorConsultas::formatear(const Instantanea& inst, char* salida, int capacidad) {
+    int n = snprintf(salida, capacidad,
+                     "desplazamiento %d\ntramas %lu\nmalformadas %lu\ncaracteres %lu\ncola %d [",
+                     inst.desplazamiento, inst.tramas, inst.malformadas, inst.caracteres,
+                     inst.largoCola);
+    if(n < 0 || n >= capacidad) return n < 0 ? 0 : capacidad - 1;
+    
+    for(int i = 0; i < inst.largoCola && n < capacidad - 3; i++) {
+        unsigned char c = (unsigned char)inst.cola[i];
+        salida[n++] = (c >= 32 && c < 127) ? (char)c : '?';
+    }
+    salida[n++] = ']';
+    salida[n++] = '\n';
+    salida[n] = '\0';
+    return n;
+}
+
+#ifndef _WIN32
+
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/// Pedido de volcado por SIGUSR2 (atómico sin bloqueo: válido en un manejador)
+static std::atomic<bool> volcadoPedido(false);
+
+/**
+ * @brief Manejador de SIGUSR2: sólo marca el pedido
+ */
+static void pedirVolcado(int) {
+    volcadoPedido.store(true);
+}
+
+// Constructor
+ServidorConsultas::ServidorConsultas(const EstadoPublicado* e, const char* rutaSocket)
+    : estado(e), escucha(-1), activo(false), atendidas(0) {
+    snprintf(ruta, sizeof(ruta), "%s", rutaSocket);
+}
+
+// Destructor
+ServidorConsultas::~ServidorConsultas() {
+    detener();
+}
+
+// Socket, señal e hilo
+bool ServidorConsultas::iniciar() {
+    escucha = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(escucha < 0) return false;
+    
+    struct sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    snprintf(dir.sun_path, sizeof(dir.sun_path), "%s", ruta);
+    unlink(ruta);
+    
+    if(bind(escucha, (struct sockaddr*)&dir, sizeof(dir)) != 0 || listen(escucha, 16) != 0) {
+        std::cerr << "[ERROR] No se pudo escuchar consultas en " << ruta << ": "
+                  << strerror(errno) << std::endl;
+        close(escucha);
+        escucha = -1;
+        return false;
+    }
+    
+    signal(SIGUSR2, pedirVolcado);
+    activo = true;
+    hilo = std::thread(&ServidorConsultas::bucle, this);
+    return true;
+}
+
+// Detener el hilo
+void ServidorConsultas::detener() {
+    if(!activo) return;
+    activo = false;
+    hilo.join();
+    close(escucha);
+    escucha = -1;
+    unlink(ruta);
+}
+
+// Bucle del hilo de consultas
+void ServidorConsultas::bucle() {
+    char texto[Instantanea::MAX_COLA + 256];
+    Instantanea inst;
+    
+    while(activo) {
+        if(volcadoPedido.exchange(false)) {
+            estado->leer(inst, 64);
+            formatear(inst, texto, sizeof(texto));
+            std::cerr << "[ESTADO]\n" << texto << std::flush;
+        }
+        
+        struct pollfd p;
+        p.fd = escucha;
+        p.events = POLLIN;
+        if(poll(&p, 1, 100) <= 0) continue;
+        
+        int fd = accept4(escucha, nullptr, nullptr, SOCK_CLOEXEC);
+        if(fd < 0) continue;
+        responder(fd);
+        close(fd);
+    }
+}
+
+// Un pedido por conexión
+void ServidorConsultas::responder(int fd) {
+    // Un cliente mudo recibe la respuesta por omisión tras 100 ms
+    struct timeval espera = { 0, 100000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+    
+    char pedido[64];
+    int largo = 0;
+    while(largo < (int)sizeof(pedido) - 1) {
+        ssize_t r = read(fd, pedido + largo, sizeof(pedido) - 1 - largo);
+        if(r <= 0) break;
+        largo += (int)r;
+        if(memchr(pedido, '\n', largo)) break;
+    }
+    pedido[largo] = '\0';
+    
+    int cantidad = 64;
+    if(strncmp(pedido, "estado", 6) == 0 && pedido[6] == ' ') {
+        cantidad = atoi(pedido + 7);
+    }
+    
+    char texto[Instantanea::MAX_COLA + 256];
+    Instantanea inst;
+    estado->leer(inst, cantidad);
+    int n = formatear(inst, texto, sizeof(texto));
+    
+    const char* p = texto;
+    while(n > 0) {
+        ssize_t w = write(fd, p, n);
+        if(w < 0 && errno == EINTR) continue;
+        if(w <= 0) break;
+        p += w;
+        n -= (int)w;
+    }
+    atendidas++;
+}
+
+#else
+
+ServidorConsultas::ServidorConsultas(const EstadoPublicado* e, const char* rutaSocket)
+    : estado(e), escucha(-1), activo(false), atendidas(0) {
+    snprintf(ruta, sizeof(ruta), "%s", rutaSocket);
+}
+ServidorConsultas::~ServidorConsultas() {}
+bool ServidorConsultas::iniciar() {
+    std::cerr << "[ERROR] Las consultas por socket sólo están disponibles en POSIX" << std::endl;
+    return false;
+}
+void ServidorConsultas::detener() {}
+void ServidorConsultas::bucle() {}
+void ServidorConsultas::responder(int) {}
+
+#endif
@@ -0,0 +1,157 @@
+// ============================================================================
+// EstadoPublicado.h - Instantáneas del Decodificador sin Bloqueos (Seqlock)
+// ============================================================================
+
+#ifndef ESTADO_PUBLICADO_H
+#define ESTADO_PUBLICADO_H
+
+#include "ObservadorCarga.h"
+#include <atomic>
+#include <thread>
+
+/**
+ * @struct Instantanea
+ * @brief Copia consistente del estado del decodificador en un instante
+ */
+struct Instantanea {
+    static const int MAX_COLA = 1024;   ///< Caracteres finales que se conservan
+    
+    int desplazamiento;         ///< Rotación neta del rotor
+    unsigned long tramas;       ///< Tramas procesadas
+    unsigned long malformadas;  ///< Líneas rechazadas por el parser
+    unsigned long caracteres;   ///< Caracteres decodificados en total
+    int largoCola;              ///< Caracteres válidos en cola
+    char cola[MAX_COLA + 1];    ///< Últimos caracteres del mensaje ('\0' al final)
+};
+
+/**
+ * @class EstadoPublicado
+ * @brief Estado del hilo decodificador publicado con un seqlock
+ * 
+ * El hilo decodificador es el único escritor: abre la sección con
+ * comenzarTrama() (secuencia impar), deja que ListaDeCarga le notifique
+ * los caracteres como observador y la cierra con terminarTrama()
+ * (secuencia par). Nunca espera a los lectores ni reserva memoria.
+ * 
+ * Los lectores (leer()) copian todo y releen la secuencia: si cambió o
+ * era impar, reintentan. Así cada instantánea corresponde al estado entre
+ * dos tramas, sin pausar la decodificación. Los campos son atómicos
+ * relajados, de modo que la copia especulativa no es una carrera.
+ * 
+ * Las re-decodificaciones de DecodificadorRetroactivo llegan por
+ * alReescribir() y corrigen la parte de la cola que todavía se conserva,
+ * así una consulta muestra el mensaje ya corregido.
+ */
+class EstadoPublicado : public ObservadorCarga {
+private:
+    alignas(64) std::atomic<unsigned long> secuencia;   ///< Impar mientras se escribe
+    std::atomic<int> desplazamiento;                    ///< Rotación tras la última trama
+    std::atomic<unsigned long> tramas;                  ///< Tramas procesadas
+    std::atomic<unsigned long> malformadas;             ///< Líneas rechazadas
+    std::atomic<unsigned long> caracteres;              ///< Caracteres insertados
+    std::atomic<char> cola[Instantanea::MAX_COLA];      ///< Anillo de los últimos caracteres
+    
+    bool abierta;               ///< Sección abierta (sólo la usa el escritor)
+    
+    void abrir();               ///< Secuencia a impar
+    void cerrar();              ///< Secuencia a par
+
+public:
+    /**
+     * @brief Constructor: estado inicial con el desplazamiento dado
+     */
+    explicit EstadoPublicado(int desplazamientoInicial = 0);
+    
+    /**
+     * @brief Abre la sección de escritura de una trama (hilo decodificador)
+     */
+    void comenzarTrama();
+    
+    /**
+     * @brief Cierra la sección publicando el rotor tras la trama
+     * @param desplazamientoRotor RotorDeMapeo::getDesplazamiento()
+     */
+    void terminarTrama(int desplazamientoRotor);
+    
+    /**
+     * @brief Cuenta una línea rechazada por el parser
+     */
+    void registrarMalformada();
+    
+    /**
+     * @brief Implementa ObservadorCarga: agrega el carácter a la cola
+     */
+    void alInsertar(char dato, unsigned long indiceTrama) override;
+    
+    /**
+     * @brief Implementa ObservadorCarga: corrige el tramo dentro de la cola
+     */
+    void alReescribir(unsigned long desde, const char* datos, int cantidad) override;
+    
+    /**
+     * @brief Copia una instantánea consistente (cualquier hilo)
+     * @param salida Destino de la copia
+     * @param maxCola Cantidad de caracteres finales a copiar (hasta MAX_COLA)
+     */
+    void leer(Instantanea& salida, int maxCola = Instantanea::MAX_COLA) const;
+};
+
+/**
+ * @class ServidorConsultas
+ * @brief Responde consultas sobre un EstadoPublicado desde su propio hilo
+ * 
+ * Escucha en un socket UNIX: cada cliente puede enviar una línea
+ * "estado [N]" (o nada) y recibe la instantánea en texto, con los
+ * últimos N caracteres (64 si no se indica). Además, al recibir SIGUSR2
+ * vuelca la instantánea por cerr. El hilo decodificador no participa.
+ * Sólo disponible en POSIX.
+ */
+class ServidorConsultas {
+private:
+    const EstadoPublicado* estado;  ///< Estado consultado
+    char ruta[108];                 ///< Ruta del socket (sun_path)
+    int escucha;                    ///< Socket de escucha (-1 si no hay)
+    std::atomic<bool> activo;       ///< false para detener el hilo
+    std::thread hilo;               ///< Hilo de consultas
+    std::atomic<unsigned long> atendidas;   ///< Consultas respondidas
+    
+    void bucle();               ///< Acepta consultas y atiende SIGUSR2
+    void responder(int fd);     ///< Lee el pedido y envía la instantánea
+
+public:
+    /**
+     * @brief Constructor
+     * @param e Estado a consultar (debe vivir más que el servidor)
+     * @param rutaSocket Ruta del socket UNIX
+     */
+    ServidorConsultas(const EstadoPublicado* e, const char* rutaSocket);
+    
+    /**
+     * @brief Destructor: detiene el hilo y borra el socket
+     */
+    ~ServidorConsultas();
+    
+    /**
+     * @brief Crea el socket, instala SIGUSR2 y arranca el hilo
+     * @return true si se pudo escuchar
+     */
+    bool iniciar();
+    
+    /**
+     * @brief Detiene el hilo de consultas
+     */
+    void detener();
+    
+    /**
+     * @brief Escribe una instantánea en texto
+     * @param inst Instantánea a formatear
+     * @param salida Buffer de destino
+     * @param capacidad Tamaño del buffer
+     * @return Bytes escritos
+     */
+    static int formatear(const Instantanea& inst, char* salida, int capacidad);
+    
+    unsigned long getAtendidas() const { return atendidas.load(); }  ///< Consultas respondidas
+};
+
+#endif // ESTADO_PUBLICADO_H
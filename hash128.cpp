@@ -0,0 +1,121 @@
+// ============================================================================
+// Hash128.cpp - Implementación de MurmurHash3 x64_128 Incremental
+// ============================================================================
+
+#include "Hash128.h"
+#include <cstring>
+#include <cstdio>
+
+static const uint64_t C1 = 0x87c37b91114253d5ULL;
+static const uint64_t C2 = 0x4cf5ad432745937fULL;
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// Mezcla final de un carril
+static inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// Lectura little-endian sin depender de la alineación
+static inline uint64_t leer64(const uint8_t* p) {
+    uint64_t v = 0;
+    for(int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+// Hexadecimal
+void Huella128::aHex(char destino[33]) const {
+    snprintf(destino, 33, "%016llx%016llx", (unsigned long long)alta, (unsigned long long)baja);
+}
+
+// Constructor
+Hash128::Hash128(uint64_t semilla) : h1(semilla), h2(semilla), largoResto(0), total(0) {}
+
+// Un bloque de 16 bytes
+void Hash128::bloque(const uint8_t* p) {
+    uint64_t k1 = leer64(p);
+    uint64_t k2 = leer64(p + 8);
+    
+    k1 *= C1; k1 = rotl64(k1, 31); k1 *= C2; h1 ^= k1;
+    h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+    
+    k2 *= C2; k2 = rotl64(k2, 33); k2 *= C1; h2 ^= k2;
+    h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+}
+
+// Agregar bytes
+void Hash128::actualizar(const void* datos, size_t n) {
+    const uint8_t* p = (const uint8_t*)datos;
+    total += n;
+    
+    // Completar el bloque que quedó a medias
+    if(largoResto > 0) {
+        size_t falta = 16 - largoResto;
+        if(n < falta) {
+            memcpy(resto + largoResto, p, n);
+            largoResto += n;
+            return;
+        }
+        memcpy(resto + largoResto, p, falta);
+        bloque(resto);
+        p += falta;
+        n -= falta;
+        largoResto = 0;
+    }
+    
+    while(n >= 16) {
+        bloque(p);
+        p += 16;
+        n -= 16;
+    }
+    
+    memcpy(resto, p, n);
+    largoResto = n;
+}
+
+// Cola y mezcla final
+Huella128 Hash128::finalizar() {
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    const uint8_t* t = resto;
+    
+    switch(largoResto) {
+        case 15: k2 ^= (uint64_t)t[14] << 48; // fallthrough
+        case 14: k2 ^= (uint64_t)t[13] << 40; // fallthrough
+        case 13: k2 ^= (uint64_t)t[12] << 32; // fallthrough
+        case 12: k2 ^= (uint64_t)t[11] << 24; // fallthrough
+        case 11: k2 ^= (uint64_t)t[10] << 16; // fallthrough
+        case 10: k2 ^= (uint64_t)t[9] << 8;   // fallthrough
+        case 9:  k2 ^= (uint64_t)t[8];
+                 k2 *= C2; k2 = rotl64(k2, 33); k2 *= C1; h2 ^= k2;
+                 // fallthrough
+        case 8:  k1 ^= (uint64_t)t[7] << 56;  // fallthrough
+        case 7:  k1 ^= (uint64_t)t[6] << 48;  // fallthrough
+        case 6:  k1 ^= (uint64_t)t[5] << 40;  // fallthrough
+        case 5:  k1 ^= (uint64_t)t[4] << 32;  // fallthrough
+        case 4:  k1 ^= (uint64_t)t[3] << 24;  // fallthrough
+        case 3:  k1 ^= (uint64_t)t[2] << 16;  // fallthrough
+        case 2:  k1 ^= (uint64_t)t[1] << 8;   // fallthrough
+        case 1:  k1 ^= (uint64_t)t[0];
+                 k1 *= C1; k1 = rotl64(k1, 31); k1 *= C2; h1 ^= k1;
+    }
+    
+    h1 ^= total;
+    h2 ^= total;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+    
+    Huella128 r = { h1, h2 };
+    return r;
+}
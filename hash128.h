@@ -0,0 +1,69 @@
+// ============================================================================
+// Hash128.h - Hash No Criptográfico de 128 Bits por Flujo
+// ============================================================================
+
+#ifndef HASH_128_H
+#define HASH_128_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct Huella128
+ * @brief Resultado de 128 bits
+ */
+struct Huella128 {
+    uint64_t alta;  ///< 64 bits superiores
+    uint64_t baja;  ///< 64 bits inferiores
+    
+    bool operator==(const Huella128& o) const { return alta == o.alta && baja == o.baja; }
+    
+    /**
+     * @brief Representación hexadecimal (32 caracteres + '\0')
+     */
+    void aHex(char destino[33]) const;
+};
+
+/**
+ * @class Hash128
+ * @brief MurmurHash3 x64_128 incremental
+ * 
+ * Procesa bloques de 16 bytes con dos carriles de multiplicación y
+ * rotación (varios GB/s), así que hashear una captura cuesta mucho menos
+ * que decodificarla. Los datos pueden entregarse en trozos de cualquier
+ * tamaño: el resultado es el mismo que con un solo bloque. No sirve
+ * contra colisiones provocadas a propósito; es para direccionar contenido
+ * propio (ej: CacheDecodificacion).
+ */
+class Hash128 {
+private:
+    uint64_t h1;            ///< Carril 1
+    uint64_t h2;            ///< Carril 2
+    uint8_t resto[16];      ///< Bytes que aún no completan un bloque
+    size_t largoResto;      ///< Cantidad de bytes en resto
+    uint64_t total;         ///< Bytes entregados
+    
+    /**
+     * @brief Mezcla un bloque de 16 bytes
+     */
+    void bloque(const uint8_t* p);
+
+public:
+    /**
+     * @brief Constructor
+     * @param semilla Semilla de ambos carriles
+     */
+    explicit Hash128(uint64_t semilla = 0);
+    
+    /**
+     * @brief Agrega bytes al hash
+     */
+    void actualizar(const void* datos, size_t n);
+    
+    /**
+     * @brief Termina y devuelve la huella (no se puede seguir actualizando)
+     */
+    Huella128 finalizar();
+};
+
+#endif // HASH_128_H
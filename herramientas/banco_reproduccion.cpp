@@ -0,0 +1,568 @@
+// ============================================================================
+// banco_reproduccion.cpp - Reproducción Determinista de Capturas con Umbrales
+// ============================================================================
+// Reproduce una captura grabada (o un flujo generado con CodificadorTramas
+// y semilla fija) por el lado maestro de un pseudoterminal, a una tasa
+// controlada o a la máxima posible. El hilo principal la lee con
+// SerialPort desde el lado esclavo y recorre el mismo camino que main:
+// armado de líneas, parsearTrama, procesar y ensamblado del mensaje.
+//
+// Por cada corrida informa tramas por segundo sostenidas, tiempo de CPU
+// del lector por trama y asignaciones de memoria (operator new contado en
+// esta herramienta); al final, el RSS pico del proceso. El mensaje
+// decodificado se compara contra un archivo dorado y la mediana de
+// tramas/s contra una línea base guardada.
+//
+// Códigos de salida: 0 bien, 1 error o reproducción incompleta, 2 el
+// mensaje no coincide con el dorado, 3 el rendimiento cayó más que el
+// umbral respecto de la base.
+//
+// Uso:
+//   banco_reproduccion [--captura <archivo> | --generar N] [--mapa-cada K]
+//                      [--masivo C] [--tasa T] [--repeticiones R]
+//                      [--estricto] [--detalle]
+//                      [--dorado <archivo>] [--guardar-dorado <archivo>]
+//                      [--base <archivo>] [--guardar-base <archivo>]
+//                      [--umbral P]
+// ============================================================================
+
+#include "CodificadorTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "SerialPort.h"
+#include "ParserTramas.h"
+#include "TramaBase.h"
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+// ----------------------------------------------------------------------------
+// Conteo de asignaciones: reemplazo del operator new global de la herramienta
+// ----------------------------------------------------------------------------
+
+static std::atomic<unsigned long> asignaciones(0);         ///< Llamadas a new
+static std::atomic<unsigned long> bytesAsignados(0);       ///< Bytes pedidos a new
+
+// Fuera de línea: si el compilador ve free() tras new[] avisa de un falso desajuste
+__attribute__((noinline)) void* operator new(size_t tam) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    bytesAsignados.fetch_add(tam, std::memory_order_relaxed);
+    void* p = malloc(tam ? tam : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void* operator new[](size_t tam) {
+    return ::operator new(tam);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @struct Flujo
+ * @brief Captura a reproducir, con el inicio de cada línea
+ */
+struct Flujo {
+    char* datos;        ///< Bytes de la captura
+    long largo;         ///< Cantidad de bytes
+    long* finLinea;     ///< Byte siguiente al '\n' de cada línea
+    long lineas;        ///< Cantidad de líneas
+    long esperadas;     ///< Líneas no vacías (las que entrega SerialPort)
+};
+
+/**
+ * @struct Corrida
+ * @brief Resultado de una reproducción
+ */
+struct Corrida {
+    long lineas;                ///< Líneas leídas
+    long tramas;                ///< Tramas válidas
+    double segundos;            ///< Primera a última línea
+    double tramasPorSegundo;    ///< Tramas válidas por segundo
+    double cpuNsPorTrama;       ///< CPU del hilo lector por trama
+    unsigned long asignaciones; ///< Llamadas a new durante la corrida
+    unsigned long bytes;        ///< Bytes pedidos durante la corrida
+    char* mensaje;              ///< Mensaje ensamblado
+    long largoMensaje;          ///< Caracteres del mensaje
+};
+
+// Reloj monótono en nanosegundos
+static long long ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU consumida por el hilo actual
+static long long cpuHiloNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Leer un archivo completo
+static char* leerArchivo(const char* ruta, long* largo) {
+    FILE* f = fopen(ruta, "rb");
+    if(!f) return nullptr;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    if(n < 0) {
+        fclose(f);
+        return nullptr;     // Sin tamaño (ej: una tubería)
+    }
+    fseek(f, 0, SEEK_SET);
+    char* datos = new char[n > 0 ? n : 1];
+    if(n > 0 && fread(datos, 1, n, f) != (size_t)n) {
+        delete[] datos;
+        fclose(f);
+        return nullptr;
+    }
+    fclose(f);
+    *largo = n;
+    return datos;
+}
+
+// Escribir un archivo completo
+static bool escribirArchivo(const char* ruta, const char* datos, long largo) {
+    FILE* f = fopen(ruta, "wb");
+    if(!f) return false;
+    bool ok = fwrite(datos, 1, largo, f) == (size_t)largo;
+    return fclose(f) == 0 && ok;
+}
+
+// Generar n tramas deterministas (misma semilla, mismo flujo)
+static void generarFlujo(Flujo& f, long n, int mapaCada, int masivo) {
+    CodificadorTramas codificador(mapaCada, false);
+    codificador.setCargaMasiva(masivo);
+    const char* texto = "REPRODUCCION DETERMINISTA DEL DECODIFICADOR PRT-7 ";
+    int largoTexto = (int)strlen(texto);
+    int porVuelta = masivo > 0 ? masivo : 1;
+    char* bloque = new char[porVuelta];
+    
+    long capacidad = 4096;
+    f.datos = new char[capacidad];
+    f.largo = 0;
+    long caracteres = 0;
+    
+    while((long)codificador.getTramas() < n) {
+        if(capacidad - f.largo < 128 + 2 * porVuelta) {
+            char* mayor = new char[capacidad * 2];
+            memcpy(mayor, f.datos, f.largo);
+            delete[] f.datos;
+            f.datos = mayor;
+            capacidad *= 2;
+        }
+        for(int k = 0; k < porVuelta; k++) bloque[k] = texto[(caracteres + k) % largoTexto];
+        caracteres += porVuelta;
+        int consumidos;
+        f.largo += codificador.codificar(bloque, porVuelta, f.datos + f.largo,
+                                         (int)(capacidad - f.largo), &consumidos);
+    }
+    delete[] bloque;
+}
+
+// Índice de líneas: SerialPort corta en '\n' o '\r' y omite las vacías
+static void indexarLineas(Flujo& f) {
+    f.lineas = 0;
+    for(long i = 0; i < f.largo; i++) {
+        if(f.datos[i] == '\n') f.lineas++;
+    }
+    if(f.largo > 0 && f.datos[f.largo - 1] != '\n') f.lineas++;
+    
+    f.finLinea = new long[f.lineas > 0 ? f.lineas : 1];
+    f.esperadas = 0;
+    long k = 0;
+    long largoActual = 0;
+    for(long i = 0; i < f.largo; i++) {
+        char c = f.datos[i];
+        if(c == '\n' || c == '\r') {
+            if(largoActual > 0) f.esperadas++;
+            largoActual = 0;
+            if(c == '\n') f.finLinea[k++] = i + 1;
+        } else {
+            largoActual++;
+        }
+    }
+    if(largoActual > 0) f.esperadas++;
+    if(k < f.lineas) f.finLinea[k++] = f.largo;
+}
+
+// Escribir todo el bloque en el maestro
+static bool escribirTodo(int fd, const char* datos, long n) {
+    while(n > 0) {
+        ssize_t w = write(fd, datos, n);
+        if(w < 0) return false;
+        datos += w;
+        n -= w;
+    }
+    return true;
+}
+
+/**
+ * @brief Envía la captura completa a la tasa pedida
+ * @param maestro Lado maestro del pty
+ * @param f Captura
+ * @param tasa Líneas por segundo (0 = lo más rápido posible)
+ * 
+ * Con tasa, cada línea tiene un instante fijo desde el comienzo; el
+ * escritor duerme a pasos cortos y envía juntas las que ya vencieron, de
+ * modo que la tasa media es exacta aunque el reloj del sueño sea grueso.
+ */
+static void escribirCaptura(int maestro, const Flujo* f, long tasa) {
+    if(tasa <= 0) {
+        const long TROZO = 4096;
+        for(long pos = 0; pos < f->largo; pos += TROZO) {
+            long m = f->largo - pos < TROZO ? f->largo - pos : TROZO;
+            if(!escribirTodo(maestro, f->datos + pos, m)) return;
+        }
+        if(f->largo > 0 && f->datos[f->largo - 1] != '\n') escribirTodo(maestro, "\n", 1);
+        return;
+    }
+    
+    long long inicio = ahoraNs();
+    long enviadas = 0;
+    long desde = 0;
+    while(enviadas < f->lineas) {
+        long long transcurrido = ahoraNs() - inicio;
+        long vencidas = (long)(transcurrido * tasa / 1000000000LL) + 1;
+        if(vencidas > f->lineas) vencidas = f->lineas;
+        
+        if(vencidas > enviadas) {
+            long hasta = f->finLinea[vencidas - 1];
+            if(!escribirTodo(maestro, f->datos + desde, hasta - desde)) return;
+            desde = hasta;
+            enviadas = vencidas;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    if(f->largo > 0 && f->datos[f->largo - 1] != '\n') escribirTodo(maestro, "\n", 1);
+}
+
+// Hilo escritor: avisa cuando ya no queda nada por enviar
+static void escribir(int maestro, const Flujo* f, long tasa, std::atomic<bool>* terminado) {
+    escribirCaptura(maestro, f, tasa);
+    terminado->store(true);
+}
+
+/**
+ * @brief Una reproducción completa sobre un pty nuevo
+ * @return false si no se pudo abrir el pty o no llegaron todas las líneas
+ */
+static bool reproducir(const Flujo& f, long tasa, bool estricto, Corrida& r) {
+    memset(&r, 0, sizeof(r));
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if(maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        std::cerr << "[ERROR] No se pudo crear el pseudoterminal" << std::endl;
+        return false;
+    }
+    
+    bool completa = false;
+    {
+        // El aviso de conexión de SerialPort no va en la tabla
+        std::streambuf* salida = std::cout.rdbuf(nullptr);
+        SerialPort serial(ptsname(maestro));
+        std::cout.rdbuf(salida);
+        if(!serial.estaConectado()) {
+            close(maestro);
+            return false;
+        }
+        ListaDeCarga carga;
+        RotorDeMapeo rotor;
+        
+        std::atomic<bool> terminado(false);
+        std::thread escritor(escribir, maestro, &f, tasa, &terminado);
+        
+        // Mismo recorrido que el bucle de main, sin las pausas de espera
+        char buffer[LARGO_MAX_LINEA];
+        long long inicioNs = 0, finNs = 0, inicioCpu = 0;
+        unsigned long inicioAsig = 0, inicioBytes = 0;
+        
+        while(r.lineas < f.esperadas) {
+            if(!serial.leerLinea(buffer, sizeof(buffer))) {
+                // 0,5 s sin datos (VTIME) con todo enviado: no llegará más
+                if(terminado.load()) break;
+                continue;
+            }
+            if(r.lineas == 0) {
+                inicioNs = ahoraNs();
+                inicioCpu = cpuHiloNs();
+                inicioAsig = asignaciones.load(std::memory_order_relaxed);
+                inicioBytes = bytesAsignados.load(std::memory_order_relaxed);
+            }
+            r.lineas++;
+            
+            TramaBase* trama = parsearTrama(buffer, estricto);
+            if(trama) {
+                trama->procesar(&carga, &rotor);
+                delete trama;
+                r.tramas++;
+            }
+        }
+        
+        // El ensamblado del mensaje también es parte del camino
+        r.largoMensaje = carga.getLongitud();
+        r.mensaje = new char[r.largoMensaje > 0 ? r.largoMensaje : 1];
+        carga.copiarMensaje(r.mensaje, (int)r.largoMensaje);
+        
+        finNs = ahoraNs();
+        long long cpu = cpuHiloNs() - inicioCpu;
+        r.asignaciones = asignaciones.load(std::memory_order_relaxed) - inicioAsig;
+        r.bytes = bytesAsignados.load(std::memory_order_relaxed) - inicioBytes;
+        r.segundos = (finNs - inicioNs) / 1e9;
+        r.tramasPorSegundo = r.segundos > 0 ? r.tramas / r.segundos : 0;
+        r.cpuNsPorTrama = r.tramas > 0 ? (double)cpu / r.tramas : 0;
+        completa = r.lineas == f.esperadas;
+        
+        escritor.join();
+    }
+    close(maestro);
+    
+    if(!completa) {
+        std::cerr << "[ERROR] Sólo llegaron " << r.lineas << " de " << f.esperadas
+                  << " líneas" << std::endl;
+    }
+    return completa;
+}
+
+// Comparador para qsort
+static int compararDobles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static void mostrarUso(const char* programa) {
+    std::cout << "Uso: " << programa << " [--captura <archivo> | --generar N] [--mapa-cada K]\n"
+              << "       [--masivo C] [--tasa T] [--repeticiones R] [--estricto] [--detalle]\n"
+              << "       [--dorado <archivo>] [--guardar-dorado <archivo>]\n"
+              << "       [--base <archivo>] [--guardar-base <archivo>] [--umbral P]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const char* captura = nullptr;
+    long generar = 200000;
+    int mapaCada = 8;
+    int masivo = 0;
+    long tasa = 0;
+    int repeticiones = 3;
+    bool estricto = false;
+    bool detalle = false;
+    const char* dorado = nullptr;
+    const char* guardarDorado = nullptr;
+    const char* base = nullptr;
+    const char* guardarBase = nullptr;
+    double umbral = 10.0;
+    
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--captura") == 0 && i + 1 < argc) {
+            captura = argv[++i];
+        } else if(strcmp(argv[i], "--generar") == 0 && i + 1 < argc) {
+            generar = atol(argv[++i]);
+        } else if(strcmp(argv[i], "--mapa-cada") == 0 && i + 1 < argc) {
+            mapaCada = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--masivo") == 0 && i + 1 < argc) {
+            masivo = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--tasa") == 0 && i + 1 < argc) {
+            tasa = atol(argv[++i]);
+        } else if(strcmp(argv[i], "--repeticiones") == 0 && i + 1 < argc) {
+            repeticiones = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--estricto") == 0) {
+            estricto = true;
+        } else if(strcmp(argv[i], "--detalle") == 0) {
+            detalle = true;
+        } else if(strcmp(argv[i], "--dorado") == 0 && i + 1 < argc) {
+            dorado = argv[++i];
+        } else if(strcmp(argv[i], "--guardar-dorado") == 0 && i + 1 < argc) {
+            guardarDorado = argv[++i];
+        } else if(strcmp(argv[i], "--base") == 0 && i + 1 < argc) {
+            base = argv[++i];
+        } else if(strcmp(argv[i], "--guardar-base") == 0 && i + 1 < argc) {
+            guardarBase = argv[++i];
+        } else if(strcmp(argv[i], "--umbral") == 0 && i + 1 < argc) {
+            umbral = atof(argv[++i]);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if(generar < 1 || tasa < 0 || repeticiones < 1 || masivo < 0 || umbral < 0) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    
+    // Captura a reproducir
+    Flujo f;
+    if(captura) {
+        f.datos = leerArchivo(captura, &f.largo);
+        if(!f.datos) {
+            std::cerr << "[ERROR] No se pudo leer " << captura << std::endl;
+            return 1;
+        }
+    } else {
+        generarFlujo(f, generar, mapaCada, masivo);
+    }
+    indexarLineas(f);
+    if(f.esperadas == 0) {
+        std::cerr << "[ERROR] La captura no tiene líneas" << std::endl;
+        return 1;
+    }
+    
+    TramaBase::setDetalle(detalle);
+    std::cout << "[INFO] " << f.esperadas << " líneas (" << f.largo << " bytes) de "
+              << (captura ? captura : "flujo generado") << ", tasa ";
+    if(tasa > 0) {
+        std::cout << tasa << " líneas/s" << std::endl;
+    } else {
+        std::cout << "máxima" << std::endl;
+    }
+    
+    std::cout << std::left << std::setw(8) << "corrida" << std::right
+              << std::setw(10) << "tramas" << std::setw(10) << "seg"
+              << std::setw(14) << "tramas/s" << std::setw(12) << "cpu ns/tr"
+              << std::setw(10) << "news" << std::setw(12) << "KB news" << std::endl;
+    std::cout << std::fixed;
+    
+    double* tasas = new double[repeticiones];
+    Corrida primera;
+    memset(&primera, 0, sizeof(primera));
+    int codigo = 0;
+    bool mensajesIguales = true;
+    
+    for(int k = 0; k < repeticiones; k++) {
+        Corrida r;
+        if(!reproducir(f, tasa, estricto, r)) {
+            delete[] r.mensaje;
+            codigo = 1;
+            break;
+        }
+        tasas[k] = r.tramasPorSegundo;
+        
+        std::cout << std::left << std::setw(8) << k + 1 << std::right
+                  << std::setw(10) << r.tramas
+                  << std::setw(10) << std::setprecision(3) << r.segundos
+                  << std::setw(14) << std::setprecision(0) << r.tramasPorSegundo
+                  << std::setw(12) << std::setprecision(1) << r.cpuNsPorTrama
+                  << std::setw(10) << r.asignaciones
+                  << std::setw(12) << r.bytes / 1024 << std::endl;
+        
+        // Todas las corridas deben decodificar exactamente lo mismo
+        if(k == 0) {
+            primera = r;
+        } else {
+            if(r.largoMensaje != primera.largoMensaje ||
+               memcmp(r.mensaje, primera.mensaje, r.largoMensaje) != 0) {
+                mensajesIguales = false;
+            }
+            delete[] r.mensaje;
+        }
+    }
+    
+    if(codigo == 0) {
+        qsort(tasas, repeticiones, sizeof(double), compararDobles);
+        double mediana = tasas[repeticiones / 2];
+        
+        struct rusage uso;
+        getrusage(RUSAGE_SELF, &uso);
+        std::cout << "[RESULTADO] Mediana " << std::setprecision(0) << mediana
+                  << " tramas/s en " << repeticiones << " corridas, RSS pico "
+                  << uso.ru_maxrss << " KB" << std::endl;
+        
+        if(!mensajesIguales) {
+            std::cout << "[FALLO] Las corridas decodificaron mensajes distintos" << std::endl;
+            codigo = 2;
+        }
+        
+        // Mensaje dorado
+        if(guardarDorado) {
+            if(escribirArchivo(guardarDorado, primera.mensaje, primera.largoMensaje)) {
+                std::cout << "[INFO] Dorado guardado en " << guardarDorado << " ("
+                          << primera.largoMensaje << " caracteres)" << std::endl;
+            } else {
+                std::cerr << "[ERROR] No se pudo escribir " << guardarDorado << std::endl;
+                codigo = 1;
+            }
+        }
+        if(dorado) {
+            long largo = 0;
+            char* esperado = leerArchivo(dorado, &largo);
+            if(!esperado) {
+                std::cerr << "[ERROR] No se pudo leer " << dorado << std::endl;
+                codigo = 1;
+            } else {
+                long i = 0;
+                long minimo = largo < primera.largoMensaje ? largo : primera.largoMensaje;
+                while(i < minimo && esperado[i] == primera.mensaje[i]) i++;
+                if(i == largo && i == primera.largoMensaje) {
+                    std::cout << "[DORADO] Coincide (" << largo << " caracteres)" << std::endl;
+                } else {
+                    std::cout << "[FALLO] El mensaje difiere del dorado en el carácter " << i
+                              << " (" << primera.largoMensaje << " decodificados, "
+                              << largo << " esperados)" << std::endl;
+                    codigo = 2;
+                }
+                delete[] esperado;
+            }
+        }
+        
+        // Línea base de rendimiento
+        if(guardarBase) {
+            FILE* fb = fopen(guardarBase, "w");
+            if(fb && fprintf(fb, "tramas_por_segundo %.0f\n", mediana) > 0 && fclose(fb) == 0) {
+                std::cout << "[INFO] Base guardada en " << guardarBase << std::endl;
+            } else {
+                std::cerr << "[ERROR] No se pudo escribir " << guardarBase << std::endl;
+                codigo = 1;
+            }
+        }
+        if(base) {
+            double referencia = 0;
+            FILE* fb = fopen(base, "r");
+            if(!fb || fscanf(fb, "tramas_por_segundo %lf", &referencia) != 1 || referencia <= 0) {
+                std::cerr << "[ERROR] Base inválida en " << base << std::endl;
+                codigo = 1;
+            } else {
+                double cambio = (mediana - referencia) * 100.0 / referencia;
+                std::cout << "[BASE] " << std::setprecision(0) << referencia << " tramas/s, cambio "
+                          << std::showpos << std::setprecision(1) << cambio << std::noshowpos
+                          << "% (umbral -" << umbral << "%)" << std::endl;
+                if(cambio < -umbral) {
+                    std::cout << "[FALLO] Regresión de rendimiento" << std::endl;
+                    if(codigo == 0) codigo = 3;
+                }
+            }
+            if(fb) fclose(fb);
+        }
+    }
+    
+    delete[] primera.mensaje;
+    delete[] tasas;
+    delete[] f.datos;
+    delete[] f.finLinea;
+    return codigo;
+}
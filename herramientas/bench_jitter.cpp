@@ -0,0 +1,260 @@
+// ============================================================================
+// bench_jitter.cpp - Latencia de Cola del Decodificador sobre un PTY
+// ============================================================================
+// Un hilo escritor envía tramas PRT-7 por el lado maestro de un
+// pseudoterminal a intervalos fijos, anotando el instante de cada envío.
+// El hilo principal las lee con SerialPort desde el lado esclavo (el mismo
+// camino que main), las decodifica y mide cuánto tardó cada una desde el
+// envío hasta quedar insertada en la ListaDeCarga.
+//
+// Se corre dos veces: primero en modo normal (lectura con timeout y pausa
+// como en main) y luego en modo de tiempo real (núcleo fijo, mlockall,
+// prerreserva y sondeo activo). El orden importa: mlockall no se deshace.
+//
+// Uso:
+//   bench_jitter [--tramas N] [--intervalo-us U] [--nucleo C] [--fifo P]
+// ============================================================================
+
+#include "CodificadorTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "SerialPort.h"
+#include "ParserTramas.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+#include "TiempoReal.h"
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @struct Flujo
+ * @brief Tramas codificadas, separadas por línea
+ */
+struct Flujo {
+    char* datos;        ///< Todas las líneas seguidas
+    int* inicio;        ///< Desplazamiento de cada línea en datos
+    int* largo;         ///< Largo de cada línea (con '\n')
+    int cantidad;       ///< Cantidad de líneas
+};
+
+// Reloj monótono en nanosegundos
+static long long ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Generar n tramas de un texto fijo
+static void generarFlujo(Flujo& f, int n) {
+    CodificadorTramas codificador(8, false);
+    const char* texto = "LATENCIA DE COLA PRT-7 ";
+    int largoTexto = (int)strlen(texto);
+    
+    f.datos = new char[(size_t)n * 16];
+    f.inicio = new int[n];
+    f.largo = new int[n];
+    f.cantidad = 0;
+    
+    int pos = 0;
+    long caracter = 0;
+    while(f.cantidad < n) {
+        int consumidos;
+        int escritos = codificador.codificar(texto + (caracter++ % largoTexto), 1,
+                                             f.datos + pos, n * 16 - pos, &consumidos);
+        if(escritos == 0) break;    // Sin lugar para otra trama
+        // Una llamada puede emitir MAP + LOAD: separar las líneas
+        for(int i = 0; i < escritos && f.cantidad < n; ) {
+            int j = i;
+            while(f.datos[pos + j] != '\n') j++;
+            f.inicio[f.cantidad] = pos + i;
+            f.largo[f.cantidad] = j - i + 1;
+            f.cantidad++;
+            i = j + 1;
+        }
+        pos += escritos;
+    }
+}
+
+// Escritor: una trama cada 'intervaloNs', anotando el instante de envío
+static void escribir(int maestro, const Flujo* f, long long intervaloNs,
+                     std::atomic<long long>* enviado, int nucleo) {
+    // Lejos del núcleo del lector, para no competir con su sondeo
+    if(nucleo >= 0) {
+        ConfigTiempoReal cfg = { nucleo, 0, false };
+        aplicarTiempoReal(cfg);
+    }
+    
+    long long inicio = ahoraNs() + 50000000LL;   // Dar tiempo al lector
+    for(int k = 0; k < f->cantidad; k++) {
+        long long objetivo = inicio + k * intervaloNs;
+        while(ahoraNs() < objetivo - 100000) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        while(ahoraNs() < objetivo) {}
+        
+        enviado[k].store(ahoraNs(), std::memory_order_release);
+        if(write(maestro, f->datos + f->inicio[k], f->largo[k]) != f->largo[k]) return;
+    }
+}
+
+// Comparador para qsort
+static int compararLatencias(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Percentil sobre un arreglo ordenado
+static long long percentil(const long long* v, int n, double p) {
+    int i = (int)(p / 100.0 * (n - 1) + 0.5);
+    return v[i];
+}
+
+/**
+ * @brief Una corrida completa sobre un pty nuevo
+ * @return Cantidad de tramas medidas (0 si falló)
+ */
+static int medir(const Flujo& f, long long intervaloNs, bool tiempoReal,
+                 const ConfigTiempoReal& cfg, long long* latencias) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if(maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        std::cerr << "No se pudo crear el pseudoterminal" << std::endl;
+        return 0;
+    }
+    
+    int medidas = 0;
+    {
+        SerialPort serial(ptsname(maestro));
+        ListaDeCarga carga;
+        RotorDeMapeo rotor;
+        if(!serial.estaConectado()) {
+            close(maestro);
+            return 0;
+        }
+        
+        // El escritor se crea antes de aplicar el modo: no hereda la política
+        std::atomic<long long>* enviado = new std::atomic<long long>[f.cantidad];
+        for(int k = 0; k < f.cantidad; k++) enviado[k].store(0);
+        bool variosNucleos = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+        int nucleoEscritor = tiempoReal && variosNucleos ? cfg.nucleo + 1 : -1;
+        std::thread escritor(escribir, maestro, &f, intervaloNs, enviado, nucleoEscritor);
+        
+        if(tiempoReal) {
+            carga.prereservar(f.cantidad);
+            TramaLoad::prereservarPool(64);
+            TramaMap::prereservarPool(64);
+            TramaCargaMasiva::prereservarPool(16);
+            aplicarTiempoReal(cfg);
+            serial.setSondeoActivo(true);
+        }
+        
+        char buffer[LARGO_MAX_LINEA];
+        long long limite = ahoraNs() + 50000000LL + (long long)f.cantidad * intervaloNs
+                           + 2000000000LL;
+        while(medidas < f.cantidad && ahoraNs() < limite) {
+            if(serial.leerLinea(buffer, sizeof(buffer))) {
+                TramaBase* trama = parsearTrama(buffer);
+                if(trama) {
+                    trama->procesar(&carga, &rotor);
+                    delete trama;
+                }
+                long long fin = ahoraNs();
+                latencias[medidas] = fin - enviado[medidas].load(std::memory_order_acquire);
+                medidas++;
+            } else if(!tiempoReal) {
+                usleep(100000);     // Igual que el bucle de main
+            }
+        }
+        
+        escritor.join();
+        delete[] enviado;
+    }
+    close(maestro);
+    return medidas;
+}
+
+// Imprimir una fila de la tabla
+static void reportar(const char* modo, long long* latencias, int n) {
+    qsort(latencias, n, sizeof(long long), compararLatencias);
+    std::cout << std::left << std::setw(12) << modo << std::right
+              << std::setw(8) << n
+              << std::setw(10) << percentil(latencias, n, 50) / 1000.0
+              << std::setw(10) << percentil(latencias, n, 99) / 1000.0
+              << std::setw(10) << percentil(latencias, n, 99.9) / 1000.0
+              << std::setw(10) << latencias[n - 1] / 1000.0 << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int tramas = 20000;
+    long intervaloUs = 200;
+    ConfigTiempoReal cfg = { 0, 0, true };
+    
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--tramas") == 0 && i + 1 < argc) {
+            tramas = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--intervalo-us") == 0 && i + 1 < argc) {
+            intervaloUs = atol(argv[++i]);
+        } else if(strcmp(argv[i], "--nucleo") == 0 && i + 1 < argc) {
+            cfg.nucleo = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--fifo") == 0 && i + 1 < argc) {
+            cfg.prioridadFifo = atoi(argv[++i]);
+        } else {
+            std::cout << "Uso: " << argv[0] << " [--tramas N] [--intervalo-us U]"
+                      << " [--nucleo C] [--fifo P]" << std::endl;
+            return 1;
+        }
+    }
+    if(tramas < 1 || intervaloUs < 1 || cfg.nucleo < 0) return 1;
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if(cpus < 2) {
+        // Con un solo núcleo, un lector SCHED_FIFO en sondeo dejaría sin
+        // CPU al escritor: se mide sólo afinidad, mlockall y sondeo
+        if(cfg.prioridadFifo > 0) {
+            std::cerr << "[WARN] Un solo núcleo disponible: se omite SCHED_FIFO" << std::endl;
+        }
+        cfg.prioridadFifo = 0;
+    } else if(cfg.nucleo + 1 >= cpus) {
+        cfg.nucleo = (int)cpus - 2;
+    }
+    
+    TramaBase::setDetalle(false);
+    Flujo f;
+    generarFlujo(f, tramas);
+    long long* latencias = new long long[tramas];
+    
+    std::cout << tramas << " tramas, una cada " << intervaloUs << " us (latencias en us)\n"
+              << std::left << std::setw(12) << "modo" << std::right << std::setw(8) << "tramas"
+              << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    
+    int codigo = 0;
+    const char* modos[2] = { "normal", "tiempo-real" };
+    for(int m = 0; m < 2; m++) {
+        int n = medir(f, intervaloUs * 1000LL, m == 1, cfg, latencias);
+        if(n == 0) {
+            codigo = 1;
+            continue;
+        }
+        if(n < tramas) {
+            std::cerr << "[WARN] " << modos[m] << ": sólo " << n << " tramas recibidas" << std::endl;
+        }
+        reportar(modos[m], latencias, n);
+    }
+    
+    delete[] latencias;
+    delete[] f.datos;
+    delete[] f.inicio;
+    delete[] f.largo;
+    return codigo;
+}
@@ -0,0 +1,235 @@
+// ============================================================================
+// generador_carga.cpp - Generador de Carga para el Modo Servidor
+// ============================================================================
+// Abre N conexiones concurrentes contra el servidor de ingesta (UNIX o TCP)
+// y transmite por cada una un flujo PRT-7 generado con CodificadorTramas,
+// repartiendo las escrituras en ronda para mantener todos los clientes vivos
+// a la vez. Reporta tramas por segundo del lado del emisor. Con --masivo
+// las cargas viajan en tramas B de hasta C caracteres en lugar de tramas L.
+//
+// Uso:
+//   generador_carga (--unix <ruta> | --tcp <puerto>) [--conexiones N]
+//                   [--tramas M] [--hilos T] [--mapa-cada K] [--masivo C]
+// ============================================================================
+
+#include "CodificadorTramas.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/**
+ * @struct Destino
+ * @brief Dirección del servidor
+ */
+struct Destino {
+    const char* rutaUnix;
+    int puertoTcp;
+};
+
+// Conectar un cliente
+static int conectar(const Destino& destino) {
+    int fd;
+    int r;
+    if(destino.rutaUnix) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd < 0) return -1;
+        struct sockaddr_un dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sun_family = AF_UNIX;
+        strncpy(dir.sun_path, destino.rutaUnix, sizeof(dir.sun_path) - 1);
+        r = connect(fd, (struct sockaddr*)&dir, sizeof(dir));
+    } else {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(fd < 0) return -1;
+        struct sockaddr_in dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sin_family = AF_INET;
+        dir.sin_port = htons((unsigned short)destino.puertoTcp);
+        dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        r = connect(fd, (struct sockaddr*)&dir, sizeof(dir));
+    }
+    if(r != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Escribir todo el bloque (los sockets son bloqueantes)
+static bool escribirTodo(int fd, const char* datos, int n) {
+    while(n > 0) {
+        ssize_t w = write(fd, datos, n);
+        if(w < 0) {
+            if(errno == EINTR) continue;
+            return false;
+        }
+        datos += w;
+        n -= (int)w;
+    }
+    return true;
+}
+
+/**
+ * @brief Trabajo de un hilo emisor: sus clientes en ronda
+ * @param fds Sockets asignados al hilo
+ * @param n Cantidad de sockets
+ * @param flujo Flujo codificado (igual para todos los clientes)
+ * @param largo Bytes del flujo
+ * @param fallidos Contador de clientes que perdieron la conexión
+ */
+static void emitir(int* fds, int n, const char* flujo, int largo, int* fallidos) {
+    const int TROZO = 4096;
+    
+    for(int pos = 0; pos < largo; pos += TROZO) {
+        int m = largo - pos < TROZO ? largo - pos : TROZO;
+        for(int i = 0; i < n; i++) {
+            if(fds[i] < 0) continue;
+            if(!escribirTodo(fds[i], flujo + pos, m)) {
+                close(fds[i]);
+                fds[i] = -1;
+                (*fallidos)++;
+            }
+        }
+    }
+    
+    for(int i = 0; i < n; i++) {
+        if(fds[i] >= 0) close(fds[i]);
+    }
+}
+
+static void mostrarUso(const char* programa) {
+    std::cout << "Uso: " << programa << " (--unix <ruta> | --tcp <puerto>) [--conexiones N]\n"
+              << "       [--tramas M] [--hilos T] [--mapa-cada K] [--masivo C]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    Destino destino = { nullptr, 0 };
+    int conexiones = 1000;
+    long tramasPorConexion = 1000;
+    int numHilos = 1;
+    int mapaCada = 8;
+    int masivo = 0;
+    
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--unix") == 0 && i + 1 < argc) {
+            destino.rutaUnix = argv[++i];
+        } else if(strcmp(argv[i], "--tcp") == 0 && i + 1 < argc) {
+            destino.puertoTcp = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--conexiones") == 0 && i + 1 < argc) {
+            conexiones = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--tramas") == 0 && i + 1 < argc) {
+            tramasPorConexion = atol(argv[++i]);
+        } else if(strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            numHilos = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--mapa-cada") == 0 && i + 1 < argc) {
+            mapaCada = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--masivo") == 0 && i + 1 < argc) {
+            masivo = atoi(argv[++i]);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    
+    if((!destino.rutaUnix && destino.puertoTcp <= 0) || conexiones < 1 ||
+       tramasPorConexion < 1 || numHilos < 1 || masivo < 0) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    if(numHilos > conexiones) numHilos = conexiones;
+    
+    // Generar el flujo una sola vez hasta alcanzar las tramas pedidas
+    CodificadorTramas codificador(mapaCada, false);
+    codificador.setCargaMasiva(masivo);
+    const char* texto = "HOLA MUNDO DESDE EL GENERADOR PRT-7 ";
+    int largoTexto = (int)strlen(texto);
+    
+    // Con tramas B se entregan 'masivo' caracteres por vuelta (una trama
+    // más los MAP intermedios): el texto se repite en un bloque contiguo
+    int porVuelta = masivo > 0 ? masivo : 1;
+    char* bloque = new char[porVuelta];
+    
+    int capacidad = 1024;
+    char* flujo = new char[capacidad];
+    int largo = 0;
+    long caracteres = 0;
+    
+    while((long)codificador.getTramas() < tramasPorConexion) {
+        if(capacidad - largo < 128 + 2 * porVuelta) {
+            char* mayor = new char[capacidad * 2];
+            memcpy(mayor, flujo, largo);
+            delete[] flujo;
+            flujo = mayor;
+            capacidad *= 2;
+        }
+        // Pocos caracteres por vuelta para no pasarse de las tramas pedidas
+        for(int k = 0; k < porVuelta; k++) bloque[k] = texto[(caracteres + k) % largoTexto];
+        caracteres += porVuelta;
+        int consumidos;
+        largo += codificador.codificar(bloque, porVuelta, flujo + largo, capacidad - largo, &consumidos);
+    }
+    delete[] bloque;
+    unsigned long tramasFlujo = codificador.getTramas();
+    
+    // Subir el límite de descriptores para miles de clientes
+    struct rlimit lim;
+    if(getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+        lim.rlim_cur = lim.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+    
+    // Abrir todas las conexiones antes de transmitir
+    int* fds = new int[conexiones];
+    for(int i = 0; i < conexiones; i++) {
+        fds[i] = conectar(destino);
+        if(fds[i] < 0) {
+            std::cerr << "Error al conectar el cliente " << i << ": " << strerror(errno) << std::endl;
+            for(int j = 0; j < i; j++) close(fds[j]);
+            delete[] fds;
+            delete[] flujo;
+            return 1;
+        }
+    }
+    std::cout << "[INFO] " << conexiones << " conexiones abiertas, " << tramasFlujo
+              << " tramas (" << largo << " bytes) por conexión" << std::endl;
+    
+    // Repartir los clientes en bloques contiguos por hilo
+    std::thread* hilos = new std::thread[numHilos];
+    int* fallidos = new int[numHilos];
+    auto inicio = std::chrono::steady_clock::now();
+    
+    for(int h = 0; h < numHilos; h++) {
+        int desde = (int)((long)conexiones * h / numHilos);
+        int hasta = (int)((long)conexiones * (h + 1) / numHilos);
+        fallidos[h] = 0;
+        hilos[h] = std::thread(emitir, fds + desde, hasta - desde, flujo, largo, &fallidos[h]);
+    }
+    
+    int totalFallidos = 0;
+    for(int h = 0; h < numHilos; h++) {
+        hilos[h].join();
+        totalFallidos += fallidos[h];
+    }
+    
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    double totalTramas = (double)tramasFlujo * (conexiones - totalFallidos);
+    
+    std::cout << "[RESULTADO] " << (long)totalTramas << " tramas en " << segundos << " s ("
+              << (long)(totalTramas / (segundos > 0 ? segundos : 1e-9)) << " tramas/s, "
+              << totalFallidos << " conexiones perdidas)" << std::endl;
+    
+    delete[] hilos;
+    delete[] fallidos;
+    delete[] fds;
+    delete[] flujo;
+    return totalFallidos ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+// ============================================================================
+// LectorMultiEnlace.cpp - Implementación de la Lectura Multi-Enlace
+// ============================================================================
+
+#include "LectorMultiEnlace.h"
+#include <cstring>
+#include <chrono>
+
+// Constructor
+LectorMultiEnlace::LectorMultiEnlace(const char* const* nombres, int n)
+    : hilos(nullptr), numEnlaces(n), frente(0), ocupadas(0), activo(false) {
+    puertos = new SerialPort*[n];
+    lineasPorEnlace = new unsigned long[n];
+    for(int i = 0; i < n; i++) {
+        puertos[i] = new SerialPort(nombres[i]);
+        lineasPorEnlace[i] = 0;
+    }
+    cola = new char[CAPACIDAD_COLA][LARGO_LINEA];
+}
+
+// Destructor
+LectorMultiEnlace::~LectorMultiEnlace() {
+    detener();
+    
+    for(int i = 0; i < numEnlaces; i++) {
+        delete puertos[i];
+    }
+    delete[] puertos;
+    delete[] lineasPorEnlace;
+    delete[] cola;
+}
+
+// Verificar enlaces
+bool LectorMultiEnlace::estaConectado() const {
+    if(numEnlaces == 0) return false;
+    for(int i = 0; i < numEnlaces; i++) {
+        if(!puertos[i]->estaConectado()) return false;
+    }
+    return true;
+}
+
+// Lanzar hilos lectores
+void LectorMultiEnlace::iniciar() {
+    if(hilos) return;
+    activo = true;
+    hilos = new std::thread[numEnlaces];
+    for(int i = 0; i < numEnlaces; i++) {
+        hilos[i] = std::thread(&LectorMultiEnlace::leerEnlace, this, i);
+    }
+}
+
+// Detener lectores (cada lectura expira en ~0.5 s por VTIME)
+void LectorMultiEnlace::detener() {
+    if(!hilos) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        activo = false;
+    }
+    hayEspacio.notify_all();
+    for(int i = 0; i < numEnlaces; i++) {
+        if(hilos[i].joinable()) hilos[i].join();
+    }
+    delete[] hilos;
+    hilos = nullptr;
+}
+
+// Hilo lector: sólo E/S, sin parseo
+void LectorMultiEnlace::leerEnlace(int indice) {
+    char linea[LARGO_LINEA];
+    
+    while(activo) {
+        if(!puertos[indice]->leerLinea(linea, LARGO_LINEA)) continue;
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        hayEspacio.wait(lock, [this] { return ocupadas < CAPACIDAD_COLA || !activo; });
+        if(!activo) break;
+        
+        int pos = (frente + ocupadas) % CAPACIDAD_COLA;
+        memcpy(cola[pos], linea, strlen(linea) + 1);
+        ocupadas++;
+        lineasPorEnlace[indice]++;
+        
+        lock.unlock();
+        hayLineas.notify_one();
+    }
+}
+
+// Consumir la siguiente línea
+bool LectorMultiEnlace::leerLinea(char* buffer, int maxLen, int esperaMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!hayLineas.wait_for(lock, std::chrono::milliseconds(esperaMs),
+                           [this] { return ocupadas > 0; })) {
+        return false;
+    }
+    
+    strncpy(buffer, cola[frente], maxLen - 1);
+    buffer[maxLen - 1] = '\0';
+    frente = (frente + 1) % CAPACIDAD_COLA;
+    ocupadas--;
+    
+    lock.unlock();
+    hayEspacio.notify_one();
+    return true;
+}
+
+int LectorMultiEnlace::getNumEnlaces() const {
+    return numEnlaces;
+}
+
+unsigned long LectorMultiEnlace::getLineasEnlace(int indice) const {
+    return lineasPorEnlace[indice];
+}
@@ -0,0 +1,102 @@
+// ============================================================================
+// LectorMultiEnlace.h - Lectura Paralela de Varios Puertos Seriales
+// ============================================================================
+
+#ifndef LECTOR_MULTI_ENLACE_H
+#define LECTOR_MULTI_ENLACE_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "SerialPort.h"
+#include "ParserTramas.h"
+
+/**
+ * @class LectorMultiEnlace
+ * @brief Agrega el ancho de banda de varios enlaces seriales de un sensor
+ * 
+ * Abre un SerialPort por enlace y lanza un hilo lector por cada uno. Los
+ * hilos sólo hacen E/S: depositan las líneas completas en una cola
+ * circular compartida y acotada. El hilo principal las consume con
+ * leerLinea(), con la misma semántica que SerialPort::leerLinea(), y se
+ * encarga de parsear y reordenar (ver BufferReorden).
+ */
+class LectorMultiEnlace {
+private:
+    static const int LARGO_LINEA = LARGO_MAX_LINEA; ///< Tamaño máximo de una línea
+    static const int CAPACIDAD_COLA = 1024; ///< Líneas en espera antes de frenar a los lectores
+    
+    SerialPort** puertos;       ///< Un puerto por enlace
+    std::thread* hilos;         ///< Un hilo lector por enlace
+    unsigned long* lineasPorEnlace; ///< Líneas recibidas por cada enlace
+    int numEnlaces;             ///< Cantidad de enlaces
+    
+    char (*cola)[LARGO_LINEA];  ///< Cola circular de líneas
+    int frente;                 ///< Próxima línea a consumir
+    int ocupadas;               ///< Líneas en la cola
+    
+    std::mutex mutex;                   ///< Protege la cola
+    std::condition_variable hayLineas;  ///< Señal para el consumidor
+    std::condition_variable hayEspacio; ///< Señal para los lectores
+    std::atomic<bool> activo;           ///< false para detener a los lectores
+    
+    /**
+     * @brief Cuerpo del hilo lector de un enlace
+     * @param indice Índice del enlace a leer
+     */
+    void leerEnlace(int indice);
+
+public:
+    /**
+     * @brief Constructor - Abre todos los enlaces
+     * @param nombres Nombres de los puertos (ej: "/dev/ttyUSB0")
+     * @param n Cantidad de enlaces
+     */
+    LectorMultiEnlace(const char* const* nombres, int n);
+    
+    /**
+     * @brief Destructor - Detiene los hilos y cierra los puertos
+     */
+    ~LectorMultiEnlace();
+    
+    /**
+     * @brief Indica si todos los enlaces se abrieron correctamente
+     */
+    bool estaConectado() const;
+    
+    /**
+     * @brief Lanza los hilos lectores
+     */
+    void iniciar();
+    
+    /**
+     * @brief Detiene y espera a los hilos lectores
+     * 
+     * Después de detener() las estadísticas por enlace son definitivas.
+     */
+    void detener();
+    
+    /**
+     * @brief Obtiene la siguiente línea recibida por cualquier enlace
+     * @param buffer Buffer donde se copiará la línea
+     * @param maxLen Tamaño máximo del buffer
+     * @param esperaMs Tiempo máximo de espera si no hay líneas
+     * @return true si se obtuvo una línea, false si expiró la espera
+     */
+    bool leerLinea(char* buffer, int maxLen, int esperaMs = 100);
+    
+    /**
+     * @brief Cantidad de enlaces abiertos
+     */
+    int getNumEnlaces() const;
+    
+    /**
+     * @brief Líneas recibidas por un enlace
+     * @param indice Índice del enlace
+     */
+    unsigned long getLineasEnlace(int indice) const;
+};
+
+#endif // LECTOR_MULTI_ENLACE_H
@@ -4,43 +4,91 @@
 
 #include "ListaDeCarga.h"
 #include <iostream>
+#include <new>
+#include <cstring>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 // Constructor del nodo
 ListaDeCarga::NodoCarga::NodoCarga(char c) 
     : dato(c), siguiente(nullptr), previo(nullptr) {}
 
 // Constructor de ListaDeCarga
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr) {}
+ListaDeCarga::ListaDeCarga()
+    : cabeza(nullptr), cola(nullptr), longitud(0), pool(64), archivo(nullptr), numObservadores(0), tramaActual(0) {}
 
 // Destructor
 ListaDeCarga::~ListaDeCarga() {
-    NodoCarga* actual = cabeza;
-    while(actual) {
-        NodoCarga* temp = actual;
-        actual = actual->siguiente;
-        delete temp;
-    }
+    // NodoCarga es trivial: basta con devolver las losas completas
+    pool.liberarTodo();
+    delete archivo;
 }
 
 // Insertar al final
 void ListaDeCarga::insertarAlFinal(char dato) {
-    NodoCarga* nuevo = new NodoCarga(dato);
+    if(archivo) {
+        // Respaldo en archivo: el carácter va directo al mapeo
+        if(!archivo->agregar(dato)) return;
+    } else {
+        NodoCarga* nuevo = new (pool.reservar()) NodoCarga(dato);
+        
+        if(!cabeza) {
+            // Primera inserción
+            cabeza = cola = nuevo;
+        } else {
+            // Insertar al final
+            cola->siguiente = nuevo;
+            nuevo->previo = cola;
+            cola = nuevo;
+        }
+    }
+    longitud++;
     
-    if(!cabeza) {
-        // Primera inserción
-        cabeza = cola = nuevo;
+    // Notificar a las etapas enganchadas
+    for(int i = 0; i < numObservadores; i++) {
+        observadores[i]->alInsertar(dato, tramaActual);
+    }
+}
+
+// Insertar un bloque al final
+void ListaDeCarga::insertarBloque(const char* datos, int n) {
+    if(n <= 0) return;
+    
+    if(archivo) {
+        if(!archivo->agregar(datos, (size_t)n)) return;
     } else {
-        // Insertar al final
-        cola->siguiente = nuevo;
-        nuevo->previo = cola;
-        cola = nuevo;
+        NodoCarga* ultimo = cola;
+        for(int i = 0; i < n; i++) {
+            NodoCarga* nuevo = new (pool.reservar()) NodoCarga(datos[i]);
+            nuevo->previo = ultimo;
+            if(ultimo) ultimo->siguiente = nuevo;
+            else cabeza = nuevo;
+            ultimo = nuevo;
+        }
+        cola = ultimo;
+    }
+    longitud += n;
+    
+    for(int i = 0; i < numObservadores; i++) {
+        for(int j = 0; j < n; j++) observadores[i]->alInsertar(datos[j], tramaActual);
     }
 }
 
 // Imprimir mensaje completo
 void ListaDeCarga::imprimirMensaje() {
     std::cout << "\n---\nMENSAJE OCULTO ENSAMBLADO:\n";
-    
+
+#ifndef _WIN32
+    if(archivo) {
+        // Sin pasar por iostream: sendfile/write desde el mapeo
+        std::cout.flush();
+        archivo->volcar(STDOUT_FILENO);
+        std::cout << "\n---\n";
+        return;
+    }
+#endif
+
     NodoCarga* actual = cabeza;
     while(actual) {
         std::cout << actual->dato;
@@ -52,9 +100,112 @@ void ListaDeCarga::imprimirMensaje() {
 
 // Imprimir estado parcial (debug)
 void ListaDeCarga::imprimirParcial() {
+    if(archivo) {
+        const char* datos = archivo->getDatos();
+        for(long i = 0; i < longitud; i++) std::cout << "[" << datos[i] << "]";
+        return;
+    }
+    
     NodoCarga* actual = cabeza;
     while(actual) {
         std::cout << "[" << actual->dato << "]";
         actual = actual->siguiente;
     }
 }
+
+// Cambiar el respaldo a un archivo mapeado
+bool ListaDeCarga::usarArchivo(const char* ruta) {
+    if(archivo || longitud > 0) return false;
+    
+    archivo = new AlmacenMapeado(ruta);
+    if(!archivo->estaListo()) {
+        delete archivo;
+        archivo = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// Memoria lista para las próximas inserciones
+bool ListaDeCarga::prereservar(long caracteres) {
+    if(caracteres <= 0) return true;
+    if(archivo) return archivo->prereservar((size_t)(longitud + caracteres));
+    pool.prereservar((size_t)caracteres);
+    return true;
+}
+
+// Recorrer en cualquiera de los dos sentidos
+void ListaDeCarga::recorrer(VisitanteCarga visitar, void* contexto, bool haciaAtras) const {
+    if(archivo) {
+        const char* datos = archivo->getDatos();
+        if(haciaAtras) {
+            for(long i = longitud - 1; i >= 0; i--) visitar(datos[i], contexto);
+        } else {
+            for(long i = 0; i < longitud; i++) visitar(datos[i], contexto);
+        }
+        return;
+    }
+    
+    if(haciaAtras) {
+        for(NodoCarga* actual = cola; actual; actual = actual->previo) visitar(actual->dato, contexto);
+    } else {
+        for(NodoCarga* actual = cabeza; actual; actual = actual->siguiente) visitar(actual->dato, contexto);
+    }
+}
+
+// Registrar observador
+bool ListaDeCarga::agregarObservador(ObservadorCarga* obs) {
+    if(!obs || numObservadores >= MAX_OBSERVADORES) return false;
+    observadores[numObservadores++] = obs;
+    return true;
+}
+
+// Fijar índice de la trama en proceso
+void ListaDeCarga::setTramaActual(unsigned long indice) {
+    tramaActual = indice;
+}
+
+// Estadísticas del pool
+const EstadisticasPool& ListaDeCarga::getEstadisticasPool() const {
+    return pool.getEstadisticas();
+}
+
+// Cantidad de caracteres
+long ListaDeCarga::getLongitud() const {
+    return longitud;
+}
+
+// Reescribir los últimos 'cantidad' nodos desde la cola
+void ListaDeCarga::reescribirSufijo(int cantidad, const char* datos) {
+    if(cantidad > longitud) cantidad = (int)longitud;
+    
+    if(archivo) {
+        memcpy(archivo->getDatos() + (longitud - cantidad), datos, cantidad);
+    } else {
+        NodoCarga* actual = cola;
+        for(int i = cantidad - 1; i >= 0; i--) {
+            actual->dato = datos[i];
+            actual = actual->previo;
+        }
+    }
+    
+    // Notificar el tramo corregido
+    for(int i = 0; i < numObservadores; i++) {
+        observadores[i]->alReescribir((unsigned long)(longitud - cantidad), datos, cantidad);
+    }
+}
+
+// Copiar el mensaje a un buffer
+int ListaDeCarga::copiarMensaje(char* destino, int max) const {
+    if(archivo) {
+        int n = longitud < max ? (int)longitud : max;
+        memcpy(destino, archivo->getDatos(), n);
+        return n;
+    }
+    
+    int n = 0;
+    for(NodoCarga* actual = cabeza; actual && n < max; actual = actual->siguiente) {
+        destino[n++] = actual->dato;
+    }
+    return n;
+}
@@ -5,12 +5,26 @@
 #ifndef LISTA_DE_CARGA_H
 #define LISTA_DE_CARGA_H
 
+#include "ObservadorCarga.h"
+#include "PoolNodos.h"
+#include "AlmacenMapeado.h"
+
+/**
+ * @brief Función llamada por cada carácter al recorrer la lista
+ * @param dato Carácter visitado
+ * @param contexto Puntero opaco del llamador
+ */
+typedef void (*VisitanteCarga)(char dato, void* contexto);
+
 /**
  * @class ListaDeCarga
  * @brief Lista doblemente enlazada que almacena los caracteres decodificados
  * 
  * Estructura de datos lineal que mantiene el orden de llegada de los
  * fragmentos de datos procesados. Permite recorrido hacia adelante y atrás.
+ * 
+ * Por defecto los caracteres viven en nodos del heap. Con usarArchivo()
+ * se guardan en cambio en un AlmacenMapeado; la interfaz no cambia.
  */
 class ListaDeCarga {
 private:
@@ -32,6 +46,14 @@ private:
     
     NodoCarga* cabeza;  ///< Puntero al primer nodo de la lista
     NodoCarga* cola;    ///< Puntero al último nodo de la lista
+    long longitud;      ///< Cantidad de caracteres almacenados
+    PoolNodos<NodoCarga> pool;  ///< Losas contiguas donde viven los nodos
+    AlmacenMapeado* archivo;    ///< Respaldo en archivo (nullptr = heap)
+    
+    static const int MAX_OBSERVADORES = 4;          ///< Límite de etapas enganchadas
+    ObservadorCarga* observadores[MAX_OBSERVADORES]; ///< Etapas notificadas en cada inserción
+    int numObservadores;                             ///< Cantidad de observadores activos
+    unsigned long tramaActual;                       ///< Índice de la trama en proceso
 
 public:
     /**
@@ -42,8 +64,9 @@ public:
     /**
      * @brief Destructor - Libera toda la memoria de los nodos
      * 
-     * Recorre la lista desde la cabeza eliminando cada nodo
-     * secuencialmente para evitar memory leaks.
+     * Los nodos viven en las losas del pool, así que se liberan en bloque
+     * (una operación por losa) en lugar de un delete por nodo. Con respaldo
+     * en archivo, el archivo queda con el mensaje completo.
      */
     ~ListaDeCarga();
     
@@ -56,11 +79,53 @@ public:
      */
     void insertarAlFinal(char dato);
     
+    /**
+     * @brief Inserta un bloque de caracteres al final en una sola operación
+     * @param datos Caracteres a insertar, en orden de llegada
+     * @param n Cantidad de caracteres
+     * 
+     * Equivale a n llamadas a insertarAlFinal(), pero enlaza los nodos en
+     * una sola pasada (o copia el bloque de una vez al archivo mapeado).
+     * Los observadores reciben cada carácter con el índice de la trama.
+     */
+    void insertarBloque(const char* datos, int n);
+    
+    /**
+     * @brief Guarda los caracteres en un archivo mapeado en lugar del heap
+     * @param ruta Archivo de respaldo (se crea o se trunca)
+     * @return false si la lista no está vacía o no se pudo mapear el archivo
+     */
+    bool usarArchivo(const char* ruta);
+    
+    /**
+     * @brief Indica si los caracteres se guardan en un archivo mapeado
+     */
+    bool usaArchivo() const { return archivo != nullptr; }
+    
+    /**
+     * @brief Deja memoria asignada y tocada para los próximos caracteres
+     * @param caracteres Cantidad de inserciones a cubrir
+     * @return false si el almacén en archivo no pudo crecer
+     * 
+     * Pensado para el modo de tiempo real: las inserciones posteriores no
+     * provocan fallos de página ni piden losas nuevas.
+     */
+    bool prereservar(long caracteres);
+    
+    /**
+     * @brief Recorre todos los caracteres en orden o en reversa
+     * @param visitar Función llamada por cada carácter
+     * @param contexto Puntero pasado a la función
+     * @param haciaAtras true para recorrer desde la cola hacia la cabeza
+     */
+    void recorrer(VisitanteCarga visitar, void* contexto, bool haciaAtras = false) const;
+    
     /**
      * @brief Imprime el mensaje completo ensamblado
      * 
      * Recorre la lista desde la cabeza e imprime todos los caracteres
-     * en secuencia, revelando el mensaje oculto decodificado.
+     * en secuencia, revelando el mensaje oculto decodificado. Con respaldo
+     * en archivo el contenido se vuelca directo a la salida estándar.
      */
     void imprimirMensaje();
     
@@ -71,6 +136,51 @@ public:
      * [X][Y][Z] para visualizar el progreso de la decodificación.
      */
     void imprimirParcial();
+    
+    /**
+     * @brief Engancha una etapa que recibirá cada carácter insertado
+     * @param obs Observador a notificar (no se libera con la lista)
+     * @return true si se registró, false si se alcanzó MAX_OBSERVADORES
+     */
+    bool agregarObservador(ObservadorCarga* obs);
+    
+    /**
+     * @brief Indica qué trama está a punto de procesarse
+     * @param indice Índice (base 1) de la trama
+     * 
+     * Los observadores reciben este índice junto con cada carácter.
+     */
+    void setTramaActual(unsigned long indice);
+    
+    /**
+     * @brief Estadísticas del pool de nodos (vivos, máximo, bytes)
+     */
+    const EstadisticasPool& getEstadisticasPool() const;
+    
+    /**
+     * @brief Cantidad de caracteres almacenados
+     */
+    long getLongitud() const;
+    
+    /**
+     * @brief Reescribe los últimos caracteres de la lista
+     * @param cantidad Cantidad de nodos finales a reescribir
+     * @param datos Nuevos caracteres, en orden de llegada
+     * 
+     * Recorre la lista hacia atrás desde la cola (o escribe directo en el
+     * archivo mapeado), por lo que el costo es proporcional a la cantidad
+     * reescrita. Los observadores reciben el tramo con alReescribir(), no
+     * con alInsertar(): es una corrección, no un carácter nuevo.
+     */
+    void reescribirSufijo(int cantidad, const char* datos);
+    
+    /**
+     * @brief Copia el mensaje ensamblado a un buffer
+     * @param destino Buffer de salida (no se termina en '\0')
+     * @param max Capacidad del buffer
+     * @return Cantidad de caracteres copiados
+     */
+    int copiarMensaje(char* destino, int max) const;
 };
 
 #endif // LISTA_DE_CARGA_H
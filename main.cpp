@@ -5,48 +5,327 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <chrono>
+#include <csignal>
 
 #include "TramaBase.h"
 #include "TramaLoad.h"
 #include "TramaMap.h"
+#include "TramaCargaMasiva.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
 #include "SerialPort.h"
+#include "ParserTramas.h"
+#include "BuscadorPatrones.h"
+#include "BufferReorden.h"
+#include "LectorMultiEnlace.h"
+#include "DecodificadorRetroactivo.h"
+#include "MemoriaCompartida.h"
+#include "ServidorIngesta.h"
+#include "TiempoReal.h"
+#include "DecodificadorLote.h"
+#include "Traza.h"
+#include "EstadoPublicado.h"
+#include "RecuperadorDesplazamiento.h"
 
 /**
- * @brief Parsea una línea de texto y crea la trama correspondiente
- * @param linea Línea leída del puerto serial (ej: "L,A" o "M,5")
- * @return Puntero a TramaBase (TramaLoad o TramaMap), o nullptr si hay error
- * 
- * Formato esperado:
- * - "L,X" -> TramaLoad con carácter X
- * - "M,N" -> TramaMap con rotación N
+ * @struct ContextoProceso
+ * @brief Estado que necesita procesarTrama() cuando la invoca BufferReorden
+ */
+struct ContextoProceso {
+    ListaDeCarga* carga;    ///< Lista donde se ensambla el mensaje
+    RotorDeMapeo* rotor;    ///< Rotor de mapeo actual
+    DecodificadorRetroactivo* retroactivo;  ///< Modo con correcciones (o nullptr)
+    PublicadorMemoria* publicador;          ///< Difusión por memoria compartida (o nullptr)
+    EstadoPublicado* estado;                ///< Instantáneas para consultas (o nullptr)
+    RecuperadorDesplazamiento* recuperador; ///< Buscando el desplazamiento inicial (o nullptr)
+    int procesadas;         ///< Tramas procesadas hasta ahora
+};
+
+static void fijarDesplazamiento(ContextoProceso* ctx);
+
+/**
+ * @brief Ejecuta y libera una trama (en orden)
+ * @param trama Trama a procesar
+ * @param contexto Puntero a ContextoProceso
+ */
+static void procesarTrama(TramaBase* trama, void* contexto) {
+    ContextoProceso* ctx = static_cast<ContextoProceso*>(contexto);
+    
+    // Sin desplazamiento inicial conocido: retener hasta decidirlo
+    if(ctx->recuperador) {
+        if(ctx->recuperador->retener(trama)) fijarDesplazamiento(ctx);
+        return;
+    }
+    TRAZA_INTERVALO("procesar");
+    
+    ctx->carga->setTramaActual(ctx->procesadas + 1);
+    if(ctx->estado) ctx->estado->comenzarTrama();
+    if(ctx->retroactivo) {
+        ctx->retroactivo->aplicar(trama);
+    } else {
+        trama->procesar(ctx->carga, ctx->rotor);
+    }
+    
+    // Los caracteres se publican al insertarse; las rotaciones, aquí
+    if(ctx->publicador && trama->getTipo() == 'M') {
+        ctx->publicador->publicarRotacion(static_cast<TramaMap*>(trama)->getRotacion(),
+                                          ctx->procesadas + 1);
+    }
+    delete trama;
+    ctx->procesadas++;
+    if(ctx->estado) ctx->estado->terminarTrama(ctx->rotor->getDesplazamiento());
+}
+
+/**
+ * @brief Termina la recuperación: rota el rotor a la mejor hipótesis y
+ *        procesa las tramas retenidas por el camino normal
+ * @param ctx Contexto con el recuperador activo
+ */
+static void fijarDesplazamiento(ContextoProceso* ctx) {
+    RecuperadorDesplazamiento* rec = ctx->recuperador;
+    ctx->recuperador = nullptr;
+    
+    int mejor = rec->getMejor();
+    int segundo = rec->getSegundo();
+    if(rec->getPuntaje(mejor) == rec->getPuntaje(segundo)) {
+        // Empate: las tramas no alcanzan para elegir; se sigue sin rotar
+        std::cout << "[WARN] Desplazamiento inicial indeterminado tras " << rec->getNumRetenidas()
+                  << " tramas (+" << mejor << " y +" << segundo << " empatan con "
+                  << rec->getPuntaje(mejor) << "); se conserva el actual" << std::endl;
+        mejor = 0;
+    } else {
+        std::cout << "[INFO] Desplazamiento inicial recuperado: +" << mejor << " tras "
+                  << rec->getNumRetenidas() << " tramas (puntaje " << rec->getPuntaje(mejor)
+                  << ", siguiente +" << segundo << " con " << rec->getPuntaje(segundo) << ")" << std::endl;
+    }
+    
+    ctx->rotor->rotar(mejor);
+    for(int i = 0; i < rec->getNumRetenidas(); i++) {
+        procesarTrama(rec->tomarRetenida(i), ctx);
+    }
+    delete rec;
+}
+
+/**
+ * @brief Milisegundos de un reloj monótono (para timeouts de reordenamiento)
+ */
+static long long ahoraMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Imprime los contadores de un pool de nodos
+ * @param nombre Tipo de objeto administrado por el pool
+ * @param e Estadísticas del pool
+ */
+static void imprimirPool(const char* nombre, const EstadisticasPool& e) {
+    std::cout << "Pool " << nombre << ": " << e.vivos << " vivos, máximo "
+              << e.maxVivos << ", " << e.bytesReservados / 1024 << " KB en "
+              << e.losas << " losas" << std::endl;
+}
+
+/**
+ * @brief Modo suscriptor: muestra el flujo que publica otro decodificador
+ * @param nombreSegmento Nombre del segmento compartido (ej: "/prt7")
+ * @param desdeInicio true para empezar por el registro más antiguo disponible
+ * @return 0 si éxito, 1 si no se pudo conectar
  */
-TramaBase* parsearTrama(char* linea) {
-    if(!linea || linea[0] == '\0') return nullptr;
+static int ejecutarSuscriptor(const char* nombreSegmento, bool desdeInicio) {
+    SuscriptorMemoria suscriptor(nombreSegmento, desdeInicio);
+    if(!suscriptor.estaConectado()) {
+        std::cerr << "[ERROR] No hay un decodificador publicando en " << nombreSegmento << std::endl;
+        return 1;
+    }
+    
+    std::cout << "[INFO] Suscrito a " << nombreSegmento << std::endl;
+    
+    RegistroDecodificado reg;
+    uint64_t perdidosAvisados = 0;
+    unsigned long recibidos = 0;
+    
+    while(true) {
+        if(suscriptor.leer(reg)) {
+            recibidos++;
+            if(suscriptor.getPerdidos() != perdidosAvisados) {
+                std::cout << "[WARN] Desborde: " << suscriptor.getPerdidos() - perdidosAvisados
+                          << " registros perdidos" << std::endl;
+                perdidosAvisados = suscriptor.getPerdidos();
+            }
+            
+            std::cout << "#" << reg.numero << " trama " << reg.indiceTrama
+                      << " t=" << reg.marcaTiempoNs / 1000000 << " ms ";
+            if(reg.tipo == 'L') {
+                std::cout << "L '" << reg.dato << "'" << std::endl;
+            } else {
+                std::cout << "M " << (reg.rotacion >= 0 ? "+" : "") << reg.rotacion << std::endl;
+            }
+        } else if(!suscriptor.escritorActivo()) {
+            // Sin registros pendientes y el escritor ya terminó
+            break;
+        } else {
+#ifdef _WIN32
+            Sleep(1);
+#else
+            usleep(1000);  // 1ms: el escritor nunca espera por nosotros
+#endif
+        }
+    }
     
-    char tipo = linea[0];
+    std::cout << "[INFO] Fin del flujo: " << recibidos << " registros, "
+              << suscriptor.getPerdidos() << " perdidos" << std::endl;
+    return 0;
+}
+
+/// Señal de apagado recibida (SIGINT/SIGTERM) en los modos de larga duración
+static volatile sig_atomic_t apagadoSolicitado = 0;
+
+/**
+ * @brief Manejador de SIGINT/SIGTERM: sólo marca el apagado
+ */
+static void solicitarApagado(int) {
+    apagadoSolicitado = 1;
+}
+
+/**
+ * @brief Modo servidor: atiende muchos flujos por sockets hasta Ctrl+C
+ * @param cfg Configuración del servidor
+ * @return 0 si éxito, 1 si no se pudo escuchar
+ */
+static int ejecutarServidor(const ConfigServidor& cfg) {
+    // Sin detalle por trama: miles de sesiones en paralelo
+    TramaBase::setDetalle(false);
     
-    // Validar formato básico
-    if(tipo != 'L' && tipo != 'M') return nullptr;
-    if(linea[1] != ',') return nullptr;
+    ServidorIngesta servidor(cfg);
+    if(!servidor.iniciar()) return 1;
     
-    if(tipo == 'L') {
-        // Trama de carga: L,X
-        char caracter = linea[2];
-        return new TramaLoad(caracter);
+    if(cfg.rutaUnix) {
+        std::cout << "[INFO] Escuchando en socket UNIX " << cfg.rutaUnix;
     } else {
-        // Trama de mapeo: M,N
-        int rotacion = atoi(&linea[2]);
-        return new TramaMap(rotacion);
+        std::cout << "[INFO] Escuchando en 127.0.0.1:" << cfg.puertoTcp;
+    }
+    std::cout << " con " << cfg.hilos << " bucles epoll (Ctrl+C para terminar)" << std::endl;
+    
+    signal(SIGINT, solicitarApagado);
+    signal(SIGTERM, solicitarApagado);
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    long long inicio = ahoraMs();
+    long long ultimoReporte = inicio;
+    unsigned long tramasReporte = 0;
+    
+    while(!apagadoSolicitado) {
+#ifdef _WIN32
+        Sleep(200);
+#else
+        usleep(200000);
+#endif
+        TRAZA_ATENDER();
+        long long ahora = ahoraMs();
+        if(ahora - ultimoReporte >= 5000) {
+            unsigned long t = servidor.getTramas();
+            std::cout << "[STATS] " << servidor.getActivas() << " sesiones activas, "
+                      << servidor.getAceptadas() << " aceptadas, "
+                      << (t - tramasReporte) * 1000 / (unsigned long)(ahora - ultimoReporte)
+                      << " tramas/s" << std::endl;
+            tramasReporte = t;
+            ultimoReporte = ahora;
+        }
     }
+    
+    servidor.detener();
+    
+    long long duracion = ahoraMs() - inicio;
+    std::cout << "\n[INFO] Servidor detenido tras " << duracion / 1000.0 << " s: "
+              << servidor.getAceptadas() << " sesiones, " << servidor.getTramas()
+              << " tramas, " << servidor.getBytes() << " bytes" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Muestra la forma de uso del programa
+ * @param programa Nombre del ejecutable (argv[0])
+ */
+static void mostrarUso(const char* programa) {
+    std::cerr << "Usa: " << programa << " [opciones] <puerto>" << std::endl;
+    std::cerr << "  --patrones <archivo>    Alertar al detectar patrones" << std::endl;
+    std::cerr << "  --enlaces <p1,p2,...>   Leer un sensor por varios enlaces" << std::endl;
+    std::cerr << "  --reordenar             Reordenar tramas por secuencia" << std::endl;
+    std::cerr << "  --ventana <N>           Tramas retenidas al reordenar (64)" << std::endl;
+    std::cerr << "  --timeout-hueco <ms>    Espera por una secuencia faltante (500)" << std::endl;
+    std::cerr << "  --correcciones          Aceptar MAP tardíos y re-decodificar" << std::endl;
+    std::cerr << "  --publicar <nombre>     Difundir por memoria compartida (ej: /prt7)" << std::endl;
+    std::cerr << "  --capacidad-shm <N>     Registros del anillo compartido (65536)" << std::endl;
+    std::cerr << "  --suscribir <nombre>    Sólo leer lo que publica otro decodificador" << std::endl;
+    std::cerr << "  --desde-inicio          Al suscribirse, empezar por lo más antiguo" << std::endl;
+    std::cerr << "  --servidor-unix <ruta>  Atender flujos por un socket UNIX" << std::endl;
+    std::cerr << "  --servidor-tcp <puerto> Atender flujos por TCP en 127.0.0.1" << std::endl;
+    std::cerr << "  --hilos <N>             Bucles epoll del servidor (1) o trabajadores del lote" << std::endl;
+    std::cerr << "  --sesiones              Resumen de cada sesión al cerrarse" << std::endl;
+    std::cerr << "  --almacen-archivo <ruta> Guardar el mensaje en un archivo mapeado" << std::endl;
+    std::cerr << "  --tiempo-real <nucleo>  Fijar a un núcleo, mlockall y prerreservar" << std::endl;
+    std::cerr << "  --fifo <prioridad>      Pedir SCHED_FIFO (1-99) para el decodificador" << std::endl;
+    std::cerr << "  --sondeo-activo         Leer sin pausas (busy-poll) en vez de dormir" << std::endl;
+    std::cerr << "  --prerreservar <N>      Caracteres prerreservados en tiempo real (1048576)" << std::endl;
+    std::cerr << "  --lote <dir|lista>      Decodificar capturas grabadas en paralelo" << std::endl;
+    std::cerr << "  --salida <dir>          Resultados y manifiesto del lote (salida_lote)" << std::endl;
+    std::cerr << "  --cache <dir>           Reutilizar resultados de capturas ya decodificadas" << std::endl;
+    std::cerr << "  --cache-max-mb <N>      Tamaño máximo de la caché en MB (1024)" << std::endl;
+    std::cerr << "  --desplazamiento <N>    Rotación inicial del rotor (0)" << std::endl;
+    std::cerr << "  --estricto              Rechazar tramas con campos sobrantes o fuera de rango" << std::endl;
+    std::cerr << "  --traza <archivo>       Intervalos por trama en JSON de Chrome (SIGUSR1 exporta)" << std::endl;
+    std::cerr << "  --consultas <ruta>      Responder el estado en vivo por un socket UNIX (y SIGUSR2)" << std::endl;
+    std::cerr << "  --recuperar <N>         Deducir el desplazamiento inicial en las primeras N tramas" << std::endl;
+    std::cerr << "                          (sin efecto si el rotor mapea igual en toda rotación)" << std::endl;
 }
 
 /**
  * @brief Función principal del decodificador
  * @param argc Cantidad de argumentos
- * @param argv Array de argumentos (argv[1] = nombre del puerto)
+ * @param argv Array de argumentos: [opciones] <puerto>
  * @return 0 si éxito, 1 si error
+ * 
+ * Opciones:
+ * - --patrones <archivo>: alerta en cuanto aparece alguno de los patrones
+ *   (uno por línea) en el mensaje decodificado
+ * - --enlaces <p1,p2,...>: lee el mismo sensor por varios puertos en
+ *   paralelo (implica --reordenar)
+ * - --reordenar: entrega las tramas con prefijo "S:" en orden de secuencia
+ * - --ventana <N> y --timeout-hueco <ms>: parámetros del reordenamiento
+ * - --correcciones: un MAP que llega después de las cargas a las que
+ *   debía afectar re-decodifica sólo el sufijo afectado del mensaje
+ *   (no se combina con --patrones ni --publicar, que ya emitieron lo
+ *   reescrito; --consultas sí muestra el mensaje corregido)
+ * - --publicar <nombre>: difunde caracteres y metadatos de trama en un
+ *   anillo de memoria compartida para suscriptores locales
+ * - --suscribir <nombre> [--desde-inicio]: en lugar de decodificar,
+ *   muestra lo que publica otro decodificador
+ * - --servidor-unix <ruta> | --servidor-tcp <puerto> [--hilos N] [--sesiones]:
+ *   modo servidor, cada cliente es un flujo independiente
+ * - --almacen-archivo <ruta>: el mensaje se acumula en un archivo mapeado
+ *   en memoria en lugar del heap (capturas de varios gigabytes)
+ * - --tiempo-real <nucleo> [--fifo P] [--prerreservar N]: modo de baja
+ *   latencia, ver aplicarTiempoReal()
+ * - --sondeo-activo: el bucle principal sondea el puerto sin dormir
+ * - --lote <dir|lista> [--salida <dir>] [--hilos N]: decodifica capturas
+ *   grabadas en un pool con robo de trabajo, sin puerto serial
+ * - --cache <dir> [--cache-max-mb N]: en modo lote, reutiliza el resultado
+ *   de capturas idénticas ya decodificadas con la misma configuración
+ * - --desplazamiento <N>: rotación inicial del rotor
+ * - --estricto: el parser rechaza campos sobrantes o fuera de rango
+ * - --traza <archivo>: registra intervalos por trama y los exporta en
+ *   formato Chrome Trace al salir o con SIGUSR1 (requiere PRT7_TRAZA)
+ * - --consultas <ruta>: un hilo aparte responde por un socket UNIX (y
+ *   vuelca por cerr con SIGUSR2) el rotor, los contadores y la cola del
+ *   mensaje, leídos sin bloquear al decodificador
+ * - --recuperar <N>: el enlace se tomó a mitad del flujo; las primeras N
+ *   tramas se decodifican con los 26 desplazamientos posibles y se sigue
+ *   con el de mejor puntaje de idioma. Si el rotor mapea igual en toda
+ *   rotación (mapeo identidad) no hay nada que distinguir y se ignora;
+ *   ante un empate se informa el desplazamiento como indeterminado
  */
 int main(int argc, char* argv[]) {
     // Banner de inicio
@@ -55,13 +334,210 @@ int main(int argc, char* argv[]) {
     std::cout << "  Sistema de Decodificación Industrial" << std::endl;
     std::cout << "========================================\n" << std::endl;
     
-    // Determinar puerto serial
-    const char* nombrePuerto;
+    // Procesar argumentos de línea de comandos
+    const char* nombrePuerto = nullptr;
+    const char* archivoPatrones = nullptr;
+    char* listaEnlaces = nullptr;
+    bool reordenar = false;
+    int ventana = 64;
+    int timeoutHueco = 500;
+    bool correcciones = false;
+    const char* segmentoPublicar = nullptr;
+    const char* segmentoSuscribir = nullptr;
+    bool desdeInicio = false;
+    long capacidadShm = 65536;
+    ConfigServidor servidor = { nullptr, 0, 1, false, 0, false };
+    const char* rutaAlmacen = nullptr;
+    ConfigTiempoReal tiempoReal = { -1, 0, false };
+    bool sondeoActivo = false;
+    long prerreserva = 1 << 20;
+    ConfigLote lote = { nullptr, "salida_lote", 0, 0, false, nullptr, 1024LL << 20 };
+    int numHilos = 0;
+    int desplazamiento = 0;
+    bool estricto = false;
+    const char* rutaTraza = nullptr;
+    const char* rutaConsultas = nullptr;
+    int ventanaRecuperacion = 0;
     
-    if(argc > 1) {
-        // Puerto especificado por línea de comandos
-        nombrePuerto = argv[1];
-    } else {
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--patrones") == 0 && i + 1 < argc) {
+            archivoPatrones = argv[++i];
+        } else if(strcmp(argv[i], "--enlaces") == 0 && i + 1 < argc) {
+            listaEnlaces = argv[++i];
+            reordenar = true;
+        } else if(strcmp(argv[i], "--reordenar") == 0) {
+            reordenar = true;
+        } else if(strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            ventana = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--timeout-hueco") == 0 && i + 1 < argc) {
+            timeoutHueco = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--correcciones") == 0) {
+            correcciones = true;
+        } else if(strcmp(argv[i], "--publicar") == 0 && i + 1 < argc) {
+            segmentoPublicar = argv[++i];
+        } else if(strcmp(argv[i], "--capacidad-shm") == 0 && i + 1 < argc) {
+            char* fin;
+            capacidadShm = strtol(argv[++i], &fin, 10);
+            if(*fin != '\0') capacidadShm = 0;     // Texto sobrante: se rechaza abajo
+        } else if(strcmp(argv[i], "--suscribir") == 0 && i + 1 < argc) {
+            segmentoSuscribir = argv[++i];
+        } else if(strcmp(argv[i], "--desde-inicio") == 0) {
+            desdeInicio = true;
+        } else if(strcmp(argv[i], "--servidor-unix") == 0 && i + 1 < argc) {
+            servidor.rutaUnix = argv[++i];
+        } else if(strcmp(argv[i], "--servidor-tcp") == 0 && i + 1 < argc) {
+            servidor.puertoTcp = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            numHilos = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--sesiones") == 0) {
+            servidor.mostrarSesiones = true;
+        } else if(strcmp(argv[i], "--almacen-archivo") == 0 && i + 1 < argc) {
+            rutaAlmacen = argv[++i];
+        } else if(strcmp(argv[i], "--tiempo-real") == 0 && i + 1 < argc) {
+            char* fin;
+            long nucleo = strtol(argv[++i], &fin, 10);
+            // Texto sobrante o núcleo inexistente: -2 se rechaza abajo
+            bool valido = *fin == '\0' && nucleo >= 0 && nucleo < nucleosDisponibles();
+            tiempoReal.nucleo = valido ? (int)nucleo : -2;
+            tiempoReal.bloquearMemoria = true;
+        } else if(strcmp(argv[i], "--fifo") == 0 && i + 1 < argc) {
+            tiempoReal.prioridadFifo = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--sondeo-activo") == 0) {
+            sondeoActivo = true;
+        } else if(strcmp(argv[i], "--prerreservar") == 0 && i + 1 < argc) {
+            prerreserva = atol(argv[++i]);
+        } else if(strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            lote.entrada = argv[++i];
+        } else if(strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            lote.dirSalida = argv[++i];
+        } else if(strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            lote.dirCache = argv[++i];
+        } else if(strcmp(argv[i], "--cache-max-mb") == 0 && i + 1 < argc) {
+            lote.maxCache = atoll(argv[++i]) << 20;
+        } else if(strcmp(argv[i], "--desplazamiento") == 0 && i + 1 < argc) {
+            desplazamiento = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--estricto") == 0) {
+            estricto = true;
+        } else if(strcmp(argv[i], "--traza") == 0 && i + 1 < argc) {
+            rutaTraza = argv[++i];
+        } else if(strcmp(argv[i], "--consultas") == 0 && i + 1 < argc) {
+            rutaConsultas = argv[++i];
+        } else if(strcmp(argv[i], "--recuperar") == 0 && i + 1 < argc) {
+            ventanaRecuperacion = atoi(argv[++i]);
+        } else if(strncmp(argv[i], "--", 2) == 0) {
+            std::cerr << "[ERROR] Opción desconocida o incompleta: " << argv[i] << std::endl;
+            mostrarUso(argv[0]);
+            return 1;
+        } else if(!nombrePuerto) {
+            // Puerto especificado por línea de comandos
+            nombrePuerto = argv[i];
+        }
+    }
+    
+    // Trazado de intervalos (sólo si se compiló con PRT7_TRAZA)
+    if(rutaTraza) {
+#ifdef PRT7_TRAZA
+        Traza::activar(rutaTraza);
+        TRAZA_HILO("principal");
+        std::cout << "[INFO] Trazando en " << rutaTraza << " (SIGUSR1 para exportar)" << std::endl;
+#else
+        std::cerr << "[WARN] --traza requiere compilar con -DPRT7_TRAZA" << std::endl;
+#endif
+    }
+    
+    // Modo suscriptor: no abre puertos ni decodifica
+    if(segmentoSuscribir) {
+        return ejecutarSuscriptor(segmentoSuscribir, desdeInicio);
+    }
+    
+    // Modo lote: capturas grabadas en lugar del puerto serial
+    if(lote.entrada) {
+        TramaBase::setDetalle(false);
+        lote.hilos = numHilos;
+        lote.desplazamiento = desplazamiento;
+        lote.estricto = estricto;
+        DecodificadorLote decodificador(lote);
+        return decodificador.ejecutar() ? 0 : 1;
+    }
+    
+    if(lote.dirCache) {
+        std::cerr << "[WARN] --cache sólo se usa en modo --lote" << std::endl;
+    }
+    
+    // Modo servidor: flujos por sockets en lugar del puerto serial
+    servidor.hilos = numHilos > 0 ? numHilos : 1;
+    servidor.desplazamiento = desplazamiento;
+    servidor.estricto = estricto;
+    if(servidor.rutaUnix || servidor.puertoTcp > 0) {
+        if(rutaConsultas) {
+            std::cerr << "[WARN] --consultas sólo se usa al leer un puerto serial" << std::endl;
+        }
+        return ejecutarServidor(servidor);
+    }
+    
+    if(capacidadShm <= 0 || (uint64_t)capacidadShm > PublicadorMemoria::MAX_CAPACIDAD) {
+        std::cerr << "[ERROR] --capacidad-shm va de 1 a " << PublicadorMemoria::MAX_CAPACIDAD << std::endl;
+        return 1;
+    }
+    
+    if(correcciones && reordenar) {
+        // Un MAP tardío sería descartado por la ventana antes de corregir
+        std::cerr << "[ERROR] --correcciones no se combina con --reordenar/--enlaces" << std::endl;
+        return 1;
+    }
+    
+    if(correcciones && (archivoPatrones || segmentoPublicar)) {
+        // Las alertas y los registros difundidos no se pueden retirar
+        // cuando un MAP tardío reescribe el sufijo del mensaje
+        std::cerr << "[ERROR] --correcciones no se combina con --patrones ni --publicar" << std::endl;
+        return 1;
+    }
+    
+    if(ventana <= 0 || timeoutHueco < 0) {
+        std::cerr << "[ERROR] --ventana debe ser positiva y --timeout-hueco no negativo" << std::endl;
+        return 1;
+    }
+    
+    if(tiempoReal.nucleo < -1) {
+        std::cerr << "[ERROR] --tiempo-real va del núcleo 0 al " << nucleosDisponibles() - 1 << std::endl;
+        return 1;
+    }
+    
+    if(tiempoReal.prioridadFifo < 0 || tiempoReal.prioridadFifo > 99 || prerreserva < 0) {
+        std::cerr << "[ERROR] --fifo va de 1 a 99 y --prerreservar no puede ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if(ventanaRecuperacion < 0 || (ventanaRecuperacion > 0 && correcciones)) {
+        // DecodificadorRetroactivo fija sus tablas al construirse
+        std::cerr << "[ERROR] --recuperar requiere N > 0 y no admite --correcciones" << std::endl;
+        return 1;
+    }
+    
+    if(sondeoActivo && listaEnlaces) {
+        // Los lectores de cada enlace ya bloquean en sus propios hilos
+        std::cerr << "[ERROR] --sondeo-activo requiere un solo puerto (no --enlaces)" << std::endl;
+        return 1;
+    }
+    
+    // Separar la lista de enlaces "p1,p2,..."
+    const int MAX_ENLACES = 16;
+    const char* enlaces[MAX_ENLACES];
+    int numEnlaces = 0;
+    
+    if(listaEnlaces) {
+        for(char* tok = strtok(listaEnlaces, ","); tok && numEnlaces < MAX_ENLACES;
+            tok = strtok(nullptr, ",")) {
+            enlaces[numEnlaces++] = tok;
+        }
+        if(numEnlaces == 0) {
+            std::cerr << "[ERROR] --enlaces requiere al menos un puerto" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Determinar puerto serial
+    if(numEnlaces == 0 && !nombrePuerto) {
         // Puerto por defecto según plataforma
 #ifdef _WIN32
         nombrePuerto = "\\\\.\\COM3";
@@ -72,85 +548,308 @@ int main(int argc, char* argv[]) {
         std::cout << "Usa: " << argv[0] << " <puerto> para especificar otro puerto\n" << std::endl;
     }
     
-    std::cout << "Conectando a puerto: " << nombrePuerto << "..." << std::endl;
+    if(numEnlaces > 0) {
+        std::cout << "Conectando a " << numEnlaces << " enlaces..." << std::endl;
+    } else {
+        std::cout << "Conectando a puerto: " << nombrePuerto << "..." << std::endl;
+    }
     
     // Inicializar estructuras de datos
     ListaDeCarga miListaDeCarga;
     RotorDeMapeo miRotorDeMapeo;
+    if(desplazamiento != 0) miRotorDeMapeo.rotar(desplazamiento);
     
-    // Conectar al puerto serial
-    SerialPort serial(nombrePuerto);
+    // Respaldo en archivo mapeado (opcional, el heap es el predeterminado)
+    if(rutaAlmacen) {
+        if(!miListaDeCarga.usarArchivo(rutaAlmacen)) {
+            std::cerr << "[ERROR] No se pudo usar " << rutaAlmacen << " como almacén" << std::endl;
+            return 1;
+        }
+        // El estado parcial por trama recorrería el archivo completo cada vez
+        TramaBase::setDetalle(false);
+        std::cout << "[INFO] Mensaje almacenado en archivo mapeado " << rutaAlmacen << std::endl;
+    }
+    
+    // Búsqueda de patrones sobre el flujo decodificado (opcional)
+    BuscadorPatrones buscador;
+    if(archivoPatrones) {
+        if(!buscador.cargarArchivo(archivoPatrones)) {
+            return 1;
+        }
+        miListaDeCarga.agregarObservador(&buscador);
+        std::cout << "[INFO] " << buscador.getNumPatrones()
+                  << " patrones cargados desde " << archivoPatrones << std::endl;
+    }
     
-    if(!serial.estaConectado()) {
+    // Difusión a suscriptores locales (opcional)
+    PublicadorMemoria* publicador = nullptr;
+    if(segmentoPublicar) {
+        publicador = new PublicadorMemoria(segmentoPublicar, (uint64_t)capacidadShm);
+        if(!publicador->estaListo()) {
+            delete publicador;
+            return 1;
+        }
+        miListaDeCarga.agregarObservador(publicador);
+        std::cout << "[INFO] Publicando en memoria compartida " << segmentoPublicar << std::endl;
+    }
+    
+    // Conectar al puerto serial (o a todos los enlaces)
+    SerialPort* serial = nullptr;
+    LectorMultiEnlace* multiEnlace = nullptr;
+    bool conectado;
+    
+    if(numEnlaces > 0) {
+        multiEnlace = new LectorMultiEnlace(enlaces, numEnlaces);
+        conectado = multiEnlace->estaConectado();
+    } else {
+        serial = new SerialPort(nombrePuerto);
+        conectado = serial->estaConectado();
+    }
+    
+    if(!conectado) {
         std::cerr << "\n[ERROR] No se pudo conectar al puerto." << std::endl;
         std::cerr << "Verifica que:" << std::endl;
         std::cerr << "  - El Arduino esté conectado" << std::endl;
         std::cerr << "  - El puerto sea correcto" << std::endl;
 #ifndef _WIN32
-        std::cerr << "  - Tengas permisos (chmod 666 " << nombrePuerto << ")" << std::endl;
+        std::cerr << "  - Tengas permisos (chmod 666 <puerto>)" << std::endl;
 #endif
+        delete serial;
+        delete multiEnlace;
+        delete publicador;
         return 1;
     }
     
+    // Ventana de reordenamiento (opcional)
+    BufferReorden* reorden = nullptr;
+    if(reordenar) {
+        reorden = new BufferReorden(ventana, timeoutHueco);
+        std::cout << "[INFO] Reordenando por secuencia (ventana " << ventana
+                  << ", timeout de hueco " << timeoutHueco << " ms)" << std::endl;
+    }
+    
+    // Decodificación con correcciones retroactivas (opcional)
+    DecodificadorRetroactivo* retroactivo = nullptr;
+    if(correcciones) {
+        retroactivo = new DecodificadorRetroactivo(&miListaDeCarga, &miRotorDeMapeo);
+        std::cout << "[INFO] Correcciones de MAP tardíos habilitadas" << std::endl;
+    }
+    
+    // Modo de baja latencia: primero reservar, después bloquear la memoria
+    if(tiempoReal.nucleo >= 0 || tiempoReal.prioridadFifo > 0) {
+        if(tiempoReal.bloquearMemoria) {
+            // El rotor ya vive en su losa; faltan la lista y las tramas
+            if(!miListaDeCarga.prereservar(prerreserva)) {
+                std::cerr << "[WARN] No se pudo prerreservar el almacén de carga" << std::endl;
+            }
+            TramaLoad::prereservarPool(64);
+            TramaMap::prereservarPool(64);
+            TramaCargaMasiva::prereservarPool(16);
+        }
+        bool completo = aplicarTiempoReal(tiempoReal);
+        std::cout << "[INFO] Modo de tiempo real" << (completo ? "" : " (parcial)")
+                  << ": núcleo " << tiempoReal.nucleo << ", SCHED_FIFO "
+                  << tiempoReal.prioridadFifo << ", " << prerreserva
+                  << " caracteres prerreservados" << std::endl;
+    }
+    
+    if(sondeoActivo) {
+        if(!serial->setSondeoActivo(true)) {
+            std::cerr << "[ERROR] El puerto no admite el sondeo activo" << std::endl;
+            delete retroactivo;
+            delete reorden;
+            delete serial;
+            delete publicador;
+            return 1;
+        }
+        std::cout << "[INFO] Lectura por sondeo activo (sin pausas)" << std::endl;
+    }
+    
+    // Consultas del estado en vivo desde otro hilo (opcional)
+    EstadoPublicado* estado = nullptr;
+    ServidorConsultas* consultas = nullptr;
+    if(rutaConsultas) {
+        estado = new EstadoPublicado(miRotorDeMapeo.getDesplazamiento());
+        miListaDeCarga.agregarObservador(estado);
+        consultas = new ServidorConsultas(estado, rutaConsultas);
+        if(!consultas->iniciar()) {
+            delete consultas;
+            delete estado;
+            delete retroactivo;
+            delete reorden;
+            delete serial;
+            delete multiEnlace;
+            delete publicador;
+            return 1;
+        }
+        std::cout << "[INFO] Consultas de estado en " << rutaConsultas
+                  << " (o kill -USR2 para volcarlo)" << std::endl;
+    }
+    
     // Bucle principal de procesamiento
-    char buffer[256];
-    int tramasProcesadas = 0;
+    char buffer[LARGO_MAX_LINEA];
+    ContextoProceso ctx = { &miListaDeCarga, &miRotorDeMapeo, retroactivo, publicador, estado,
+                            nullptr, 0 };
+    if(ventanaRecuperacion > 0) {
+        ctx.recuperador = new RecuperadorDesplazamiento(&miRotorDeMapeo, ventanaRecuperacion);
+        if(!ctx.recuperador->puedeDistinguir()) {
+            // Todas las hipótesis decodifican igual: no hay desplazamiento que buscar
+            std::cout << "[WARN] --recuperar se ignora: el rotor mapea igual en todos los "
+                      << "desplazamientos" << std::endl;
+            delete ctx.recuperador;
+            ctx.recuperador = nullptr;
+        } else {
+            std::cout << "[INFO] Recuperando el desplazamiento inicial en " << ventanaRecuperacion
+                      << " tramas" << std::endl;
+        }
+    }
+    int tramasRecibidas = 0;
     int intentosSinDatos = 0;
     const int MAX_INTENTOS_SIN_DATOS = 50;  // ~5 segundos sin datos
+    const long long MS_SIN_DATOS_SONDEO = 5000;
+    long long ultimoDatoMs = ahoraMs();
     
     std::cout << "\n[INFO] Esperando tramas del Arduino..." << std::endl;
     std::cout << "[INFO] Presiona RESET en el Arduino si no transmite\n" << std::endl;
     
+    if(multiEnlace) multiEnlace->iniciar();
+    
     while(true) {
-        if(serial.leerLinea(buffer, sizeof(buffer))) {
+        TRAZA_ATENDER();
+        TRAZA_MARCA(inicioLectura);
+        bool hayLinea = multiEnlace ? multiEnlace->leerLinea(buffer, sizeof(buffer))
+                                    : serial->leerLinea(buffer, sizeof(buffer));
+        
+        if(hayLinea) {
             // Se recibió una línea
+            TRAZA_CERRAR("leer", inicioLectura);
             intentosSinDatos = 0;
+            if(sondeoActivo) ultimoDatoMs = ahoraMs();
             
             // Parsear y procesar
-            TramaBase* trama = parsearTrama(buffer);
+            TRAZA_MARCA(inicioParseo);
+            TramaBase* trama = parsearTrama(buffer, estricto);
+            TRAZA_CERRAR("parsear", inicioParseo);
             
             if(trama) {
-                // Trama válida - procesar
-                trama->procesar(&miListaDeCarga, &miRotorDeMapeo);
-                delete trama;
-                tramasProcesadas++;
+                // Trama válida - procesar (en orden de secuencia si aplica)
+                tramasRecibidas++;
+                if(reorden && trama->tieneSecuencia()) {
+                    reorden->insertar(trama, ahoraMs(), procesarTrama, &ctx);
+                } else {
+                    procesarTrama(trama, &ctx);
+                }
             } else {
                 // Trama mal formada
+                if(estado) estado->registrarMalformada();
                 std::cout << "[WARN] Trama mal formada: [" << buffer << "]" << std::endl;
             }
         } else {
             // No hay datos disponibles
             intentosSinDatos++;
             
-            // Si hemos procesado tramas y no llegan más datos, terminar
-            if(tramasProcesadas > 0 && intentosSinDatos >= MAX_INTENTOS_SIN_DATOS) {
+            // Un hueco de secuencia pudo expirar sin que lleguen tramas
+            if(reorden) reorden->avanzar(ahoraMs(), procesarTrama, &ctx);
+            
+            if(sondeoActivo) {
+                // Sin pausas: el fin del flujo se decide por tiempo, no por intentos
+                if(tramasRecibidas > 0 && ahoraMs() - ultimoDatoMs >= MS_SIN_DATOS_SONDEO) {
+                    std::cout << "\n[INFO] No se reciben más datos. Finalizando..." << std::endl;
+                    break;
+                }
+                continue;
+            }
+            
+            // Si hemos recibido tramas y no llegan más datos, terminar
+            if(tramasRecibidas > 0 && intentosSinDatos >= MAX_INTENTOS_SIN_DATOS) {
                 std::cout << "\n[INFO] No se reciben más datos. Finalizando..." << std::endl;
                 break;
             }
             
-            // Pequeña pausa para no saturar el CPU
+            // Pequeña pausa para no saturar el CPU (el multi-enlace ya espera)
+            if(!multiEnlace) {
 #ifdef _WIN32
-            Sleep(100);  // 100ms
+                Sleep(100);  // 100ms
 #else
-            usleep(100000);  // 100ms
+                usleep(100000);  // 100ms
 #endif
+            }
         }
     }
     
+    if(multiEnlace) multiEnlace->detener();
+    if(reorden) reorden->vaciar(procesarTrama, &ctx);
+    if(ctx.recuperador) fijarDesplazamiento(&ctx);  // Flujo más corto que la ventana
+    
+    int tramasProcesadas = ctx.procesadas;
+    
+    // El hilo de consultas lee el estado: detenerlo antes de liberar nada
+    if(consultas) {
+        std::cout << "[INFO] Consultas de estado atendidas: " << consultas->getAtendidas() << std::endl;
+        delete consultas;
+    }
+    
     // Verificar si se procesó algo
     if(tramasProcesadas == 0) {
         std::cout << "\n[WARN] No se recibieron tramas del Arduino." << std::endl;
         std::cout << "Verifica que el Arduino esté transmitiendo." << std::endl;
+        delete estado;
+        delete retroactivo;
+        delete reorden;
+        delete serial;
+        delete multiEnlace;
+        delete publicador;
         return 1;
     }
     
     // Mostrar mensaje final
     std::cout << "\nFlujo de datos terminado." << std::endl;
     std::cout << "Total de tramas procesadas: " << tramasProcesadas << std::endl;
+    if(archivoPatrones) {
+        std::cout << "Coincidencias de patrones: " << buscador.getTotalCoincidencias() << std::endl;
+    }
+    if(multiEnlace) {
+        for(int i = 0; i < multiEnlace->getNumEnlaces(); i++) {
+            std::cout << "Enlace " << enlaces[i] << ": "
+                      << multiEnlace->getLineasEnlace(i) << " líneas" << std::endl;
+        }
+    }
+    if(reorden) {
+        std::cout << "Reordenamiento: " << reorden->getEntregadas() << " entregadas, "
+                  << reorden->getPerdidas() << " perdidas, "
+                  << reorden->getDescartadas() << " descartadas, ocupación máxima "
+                  << reorden->getMaxRetenidas() << std::endl;
+    }
+    if(publicador) {
+        std::cout << "Registros publicados en memoria compartida: "
+                  << publicador->getPublicados() << std::endl;
+    }
+    if(retroactivo) {
+        std::cout << "Correcciones: " << retroactivo->getCorrecciones() << " MAP tardíos, "
+                  << retroactivo->getRedecodificados() << " caracteres re-decodificados, "
+                  << retroactivo->getDescartadas() << " cargas descartadas" << std::endl;
+    }
+    
+    if(miListaDeCarga.usaArchivo()) {
+        std::cout << "Almacén en archivo: " << miListaDeCarga.getLongitud()
+                  << " caracteres en " << rutaAlmacen << std::endl;
+    } else {
+        imprimirPool("NodoCarga", miListaDeCarga.getEstadisticasPool());
+    }
+    imprimirPool("TramaLoad", TramaLoad::getEstadisticasPool());
+    imprimirPool("TramaMap", TramaMap::getEstadisticasPool());
+    imprimirPool("TramaCargaMasiva", TramaCargaMasiva::getEstadisticasPool());
     
     miListaDeCarga.imprimirMensaje();
     
     std::cout << "\nLiberando memoria... Sistema apagado." << std::endl;
     
+    delete estado;
+    delete retroactivo;
+    delete reorden;
+    delete serial;
+    delete multiEnlace;
+    delete publicador;
+    
     return 0;
 }
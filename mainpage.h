@@ -12,9 +12,10 @@
  * 
  * Sistema completo de decodificación del protocolo industrial PRT-7.
  * El protocolo transmite instrucciones para ensamblar mensajes ocultos
- * usando dos tipos de tramas:
+ * usando tres tipos de tramas:
  * - **Tramas LOAD (L)**: Cargan fragmentos de datos
  * - **Tramas MAP (M)**: Modifican el estado del rotor de cifrado
+ * - **Tramas de carga masiva (B)**: Cargan una cadena completa por trama
  * 
  * @section arch_sec Arquitectura
  * 
@@ -31,6 +32,8 @@
  * ```
  * L,X  -> Carga el carácter X (será decodificado)
  * M,N  -> Rota el rotor N posiciones
+ * B,N,XXXX -> Carga los N caracteres XXXX (hasta 1024) con la rotación actual
+ * S:L,X / S:M,N / S:B,N,XXXX -> Igual, con número de secuencia S (opcional)
  * ```
  * 
  * Ejemplo de secuencia:
@@ -60,14 +63,94 @@
  *    decodificador_prt7.exe COM3        # Windows
  *    ```
  * 
+ * 4. Opciones adicionales:
+ *    - `--patrones <archivo>`: alerta en consola en cuanto aparece alguno
+ *      de los patrones (uno por línea) en el mensaje decodificado
+ *    - `--enlaces <p1,p2,...>`: lee un mismo sensor repartido en varios
+ *      puertos y reordena las tramas por número de secuencia
+ *    - `--reordenar`, `--ventana <N>`, `--timeout-hueco <ms>`: control de
+ *      la ventana de reordenamiento (BufferReorden)
+ *    - `--correcciones`: acepta MAP tardíos o corregidos y re-decodifica
+ *      sólo el sufijo afectado del mensaje (DecodificadorRetroactivo); no
+ *      se combina con `--patrones` ni `--publicar`
+ *    - `--publicar <nombre>`: difunde el flujo decodificado en un anillo
+ *      de memoria compartida POSIX; otro proceso lo lee con
+ *      `--suscribir <nombre> [--desde-inicio]`
+ *    - `--servidor-unix <ruta>` / `--servidor-tcp <puerto>`: acepta miles
+ *      de flujos PRT-7 concurrentes, cada uno con su propia sesión de
+ *      decodificación; `--hilos <N>` bucles epoll, `--sesiones` imprime el
+ *      resumen de cada cliente. `herramientas/generador_carga.cpp` genera
+ *      la carga de prueba
+ *    - `--almacen-archivo <ruta>`: el mensaje se guarda en un archivo
+ *      mapeado en memoria en vez del heap; al terminar el archivo contiene
+ *      el mensaje completo
+ *    - `--tiempo-real <nucleo> [--fifo <prioridad>] [--prerreservar <N>]`:
+ *      fija el decodificador a un núcleo, bloquea la memoria y prerreserva
+ *      la lista y las tramas; `--sondeo-activo` lee el puerto sin pausas.
+ *      Con SCHED_FIFO y sondeo, el núcleo elegido debe quedar dedicado.
+ *      `herramientas/bench_jitter.cpp` compara la latencia de cola con y
+ *      sin este modo sobre un pseudoterminal
+ *    - `--lote <dir|lista> [--salida <dir>] [--hilos <N>]`: decodifica
+ *      capturas grabadas en un solo proceso; deja un `.txt` por captura y
+ *      un `manifiesto.tsv` con los tiempos
+ *    - `--cache <dir> [--cache-max-mb <N>]`: con `--lote`, guarda cada
+ *      resultado bajo el hash de la captura y de la configuración, y lo
+ *      reutiliza si la misma captura vuelve a llegar
+ *    - `--desplazamiento <N>` y `--estricto`: rotación inicial del rotor y
+ *      parser que rechaza campos sobrantes o fuera de rango
+ *    - `--traza <archivo>`: con `-DPRT7_TRAZA`, registra leer, parsear,
+ *      procesar, salida y rotar de cada trama en anillos por hilo y los
+ *      exporta como JSON de Chrome Trace al salir o con `kill -USR1`
+ *    - `--consultas <ruta>`: `echo "estado 80" | nc -U <ruta>` devuelve el
+ *      desplazamiento del rotor, los contadores y los últimos 80
+ *      caracteres; `kill -USR2` los vuelca por la consola. La lectura usa
+ *      un seqlock y nunca detiene al hilo decodificador
+ *    - `--recuperar <N>`: al engancharse a mitad de un flujo, decodifica
+ *      las primeras N tramas con los 26 desplazamientos a la vez, elige el
+ *      que mejor se parece a texto en español o inglés y sigue normalmente.
+ *      Requiere un rotor cuyo mapeo cambie con la rotación: con el mapeo
+ *      identidad se ignora, y ante un empate se informa indeterminado
+ * 
+ * `herramientas/banco_reproduccion.cpp` reproduce una captura (o un flujo
+ * generado con semilla fija) por un pseudoterminal, por el mismo camino
+ * que el modo serial, e informa tramas/s, CPU por trama, asignaciones y
+ * RSS pico. Con `--dorado` y `--base [--umbral P]` termina con código
+ * distinto de cero si el mensaje cambia o el rendimiento cae más de P%.
+ * 
+ * `pruebas/` tiene una prueba de comportamiento por módulo. Como las
+ * herramientas, cada una es un programa que se enlaza con las fuentes
+ * del decodificador salvo main.cpp; usa los contadores de
+ * `pruebas/verificacion.h` y termina con código distinto de cero si
+ * falla alguna verificación.
+ * 
  * @section classes_sec Clases Principales
  * 
  * - TramaBase: Clase base abstracta para polimorfismo
  * - TramaLoad: Implementa carga de fragmentos
  * - TramaMap: Implementa rotación del rotor
+ * - TramaCargaMasiva: Carga de una cadena completa en una sola pasada
  * - RotorDeMapeo: Lista circular para cifrado César
  * - ListaDeCarga: Lista doble para almacenar resultado
+ * - AlmacenMapeado: Respaldo de ListaDeCarga en un archivo mapeado
  * - SerialPort: Comunicación multiplataforma
+ * - PoolNodos: Asignador por tipo en losas alineadas a línea de caché
+ * - BufferReorden: Ventana de reordenamiento por secuencia
+ * - LectorMultiEnlace: Lectura paralela de varios enlaces
+ * - TablaMapeo: Mapeo precalculado del rotor para cada desplazamiento
+ * - DecodificadorRetroactivo: Correcciones tardías con árbol de Fenwick
+ * - PublicadorMemoria / SuscriptorMemoria: Anillo en memoria compartida
+ * - BuscadorPatrones: Autómata Aho-Corasick sobre el flujo decodificado
+ * - SesionDecodificador: Estado de decodificación de un cliente
+ * - ServidorIngesta: Bucles epoll para clientes UNIX/TCP
+ * - CodificadorTramas: Genera tramas LOAD/MAP a partir de un texto
+ * - PoolTrabajo: Pool de hilos con robo de trabajo
+ * - DecodificadorLote: Capturas grabadas, partidas o agrupadas por tamaño
+ * - Hash128: MurmurHash3 de 128 bits incremental
+ * - CacheDecodificacion: Resultados en disco por hash de contenido
+ * - Traza: Intervalos por trama exportados en formato Chrome Trace
+ * - EstadoPublicado / ServidorConsultas: Instantáneas del decodificador
+ *   con seqlock, consultables por socket UNIX
+ * - RecuperadorDesplazamiento: Desplazamiento inicial por puntaje de idioma
  * 
  * @section author_sec Autor
  * 
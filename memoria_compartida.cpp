@@ -0,0 +1,272 @@
+// ============================================================================
+// MemoriaCompartida.cpp - Implementación del Anillo en Memoria Compartida
+// ============================================================================
+
+#include "MemoriaCompartida.h"
+
+#ifndef _WIN32
+
+#include <iostream>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const uint32_t MAGIA_ANILLO = 0x50525437;   // "PRT7"
+static const uint32_t VERSION_ANILLO = 1;
+
+// Reloj de pared en nanosegundos
+static uint64_t ahoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Bytes del segmento: cabecera en su propia línea + ranuras
+static size_t tamanioSegmento(uint64_t capacidad) {
+    size_t cab = (sizeof(CabeceraAnillo) + 63) / 64 * 64;
+    return cab + capacidad * sizeof(RanuraAnillo);
+}
+
+// ===== PUBLICADOR =====
+
+// Constructor
+PublicadorMemoria::PublicadorMemoria(const char* nombreSegmento, uint64_t capacidad)
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), siguiente(0), bytesMapeados(0) {
+    strncpy(nombre, nombreSegmento, sizeof(nombre) - 1);
+    nombre[sizeof(nombre) - 1] = '\0';
+    
+    if(capacidad > MAX_CAPACIDAD) {
+        std::cerr << "Capacidad de memoria compartida fuera de rango: " << capacidad << std::endl;
+        return;
+    }
+    
+    // Redondear a potencia de 2 para indexar con máscara (sin pasar del tope)
+    uint64_t cap = 1;
+    while(cap < capacidad && cap < MAX_CAPACIDAD) cap <<= 1;
+    
+    shm_unlink(nombre);     // Descartar un segmento viejo del mismo nombre
+    int fd = shm_open(nombre, O_CREAT | O_RDWR, 0644);
+    if(fd < 0) {
+        std::cerr << "Error al crear memoria compartida " << nombre << std::endl;
+        return;
+    }
+    
+    size_t bytes = tamanioSegmento(cap);
+    if(ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        shm_unlink(nombre);
+        return;
+    }
+    
+    void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) {
+        shm_unlink(nombre);
+        return;
+    }
+    
+    // El segmento nuevo llega en ceros: construir los atómicos en su lugar
+    cabecera = new (base) CabeceraAnillo();
+    ranuras = reinterpret_cast<RanuraAnillo*>(
+        static_cast<char*>(base) + tamanioSegmento(0));
+    for(uint64_t i = 0; i < cap; i++) {
+        new (&ranuras[i]) RanuraAnillo();
+        ranuras[i].secuencia.store(0, std::memory_order_relaxed);
+    }
+    
+    cabecera->capacidad = cap;
+    cabecera->version = VERSION_ANILLO;
+    cabecera->escritos.store(0, std::memory_order_relaxed);
+    cabecera->activo.store(1, std::memory_order_relaxed);
+    mascara = cap - 1;
+    bytesMapeados = bytes;
+    
+    // La magia se escribe al final: un lector no ve un segmento a medias
+    std::atomic_thread_fence(std::memory_order_release);
+    cabecera->magia = MAGIA_ANILLO;
+}
+
+// Destructor
+PublicadorMemoria::~PublicadorMemoria() {
+    if(!cabecera) return;
+    cabecera->activo.store(0, std::memory_order_release);
+    munmap(cabecera, bytesMapeados);
+    shm_unlink(nombre);
+}
+
+bool PublicadorMemoria::estaListo() const {
+    return cabecera != nullptr;
+}
+
+// Escritura con seqlock por ranura (nunca espera a los lectores)
+void PublicadorMemoria::publicar(char tipo, char dato, int32_t rotacion,
+                                 unsigned long indiceTrama) {
+    if(!cabecera) return;
+    
+    RanuraAnillo& r = ranuras[siguiente & mascara];
+    uint64_t carga = (uint64_t)(unsigned char)tipo
+                   | (uint64_t)(unsigned char)dato << 8
+                   | (uint64_t)(uint32_t)rotacion << 32;
+    
+    r.secuencia.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    r.marcaTiempo.store(ahoraNs(), std::memory_order_relaxed);
+    r.indiceTrama.store(indiceTrama, std::memory_order_relaxed);
+    r.carga.store(carga, std::memory_order_relaxed);
+    r.secuencia.store(siguiente + 1, std::memory_order_release);
+    
+    siguiente++;
+    cabecera->escritos.store(siguiente, std::memory_order_release);
+}
+
+// Carácter decodificado
+void PublicadorMemoria::alInsertar(char dato, unsigned long indiceTrama) {
+    publicar('L', dato, 0, indiceTrama);
+}
+
+// Rotación del rotor
+void PublicadorMemoria::publicarRotacion(int rotacion, unsigned long indiceTrama) {
+    publicar('M', '\0', rotacion, indiceTrama);
+}
+
+uint64_t PublicadorMemoria::getPublicados() const {
+    return siguiente;
+}
+
+// ===== SUSCRIPTOR =====
+
+// Constructor
+SuscriptorMemoria::SuscriptorMemoria(const char* nombreSegmento, bool desdeInicio)
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), capacidad(0),
+      cursor(0), perdidos(0), bytesMapeados(0) {
+    int fd = shm_open(nombreSegmento, O_RDONLY, 0);
+    if(fd < 0) {
+        std::cerr << "Error al abrir memoria compartida " << nombreSegmento << std::endl;
+        return;
+    }
+    
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < tamanioSegmento(1)) {
+        close(fd);
+        return;
+    }
+    
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) return;
+    
+    const CabeceraAnillo* cab = static_cast<const CabeceraAnillo*>(base);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(cab->magia != MAGIA_ANILLO || cab->version != VERSION_ANILLO ||
+       cab->capacidad == 0 || cab->capacidad > PublicadorMemoria::MAX_CAPACIDAD ||
+       tamanioSegmento(cab->capacidad) > (size_t)st.st_size) {
+        std::cerr << "Segmento " << nombreSegmento << " no es un anillo PRT-7" << std::endl;
+        munmap(base, st.st_size);
+        return;
+    }
+    
+    cabecera = cab;
+    ranuras = reinterpret_cast<const RanuraAnillo*>(
+        static_cast<const char*>(base) + tamanioSegmento(0));
+    capacidad = cab->capacidad;
+    mascara = capacidad - 1;
+    bytesMapeados = st.st_size;
+    
+    uint64_t escritos = cabecera->escritos.load(std::memory_order_acquire);
+    if(desdeInicio) {
+        cursor = escritos > capacidad ? escritos - capacidad : 0;
+    } else {
+        cursor = escritos;
+    }
+}
+
+// Destructor
+SuscriptorMemoria::~SuscriptorMemoria() {
+    if(cabecera) munmap(const_cast<CabeceraAnillo*>(cabecera), bytesMapeados);
+}
+
+bool SuscriptorMemoria::estaConectado() const {
+    return cabecera != nullptr;
+}
+
+// Lectura con validación del seqlock
+bool SuscriptorMemoria::leer(RegistroDecodificado& reg) {
+    if(!cabecera) return false;
+    
+    while(true) {
+        uint64_t escritos = cabecera->escritos.load(std::memory_order_acquire);
+        if(cursor >= escritos) return false;
+        
+        // El escritor nos dio la vuelta: saltar a lo más antiguo válido
+        if(escritos - cursor > capacidad) {
+            perdidos += escritos - capacidad - cursor;
+            cursor = escritos - capacidad;
+        }
+        
+        const RanuraAnillo& r = ranuras[cursor & mascara];
+        uint64_t s1 = r.secuencia.load(std::memory_order_acquire);
+        uint64_t marca = r.marcaTiempo.load(std::memory_order_relaxed);
+        uint64_t indice = r.indiceTrama.load(std::memory_order_relaxed);
+        uint64_t carga = r.carga.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t s2 = r.secuencia.load(std::memory_order_relaxed);
+        
+        if(s1 != cursor + 1 || s2 != s1) {
+            // Ranura reescrita mientras se leía: se perdió este registro
+            perdidos++;
+            cursor++;
+            continue;
+        }
+        
+        reg.numero = cursor;
+        reg.marcaTiempoNs = marca;
+        reg.indiceTrama = indice;
+        reg.tipo = (char)(carga & 0xFF);
+        reg.dato = (char)((carga >> 8) & 0xFF);
+        reg.rotacion = (int32_t)(uint32_t)(carga >> 32);
+        cursor++;
+        return true;
+    }
+}
+
+bool SuscriptorMemoria::escritorActivo() const {
+    return cabecera && cabecera->activo.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t SuscriptorMemoria::getPerdidos() const {
+    return perdidos;
+}
+
+#else
+// ===== WINDOWS: sin memoria compartida POSIX =====
+
+#include <iostream>
+
+PublicadorMemoria::PublicadorMemoria(const char* nombreSegmento, uint64_t)
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), siguiente(0), bytesMapeados(0) {
+    nombre[0] = '\0';
+    std::cerr << "Memoria compartida no disponible en Windows (" << nombreSegmento << ")" << std::endl;
+}
+PublicadorMemoria::~PublicadorMemoria() {}
+bool PublicadorMemoria::estaListo() const { return false; }
+void PublicadorMemoria::publicar(char, char, int32_t, unsigned long) {}
+void PublicadorMemoria::alInsertar(char, unsigned long) {}
+void PublicadorMemoria::publicarRotacion(int, unsigned long) {}
+uint64_t PublicadorMemoria::getPublicados() const { return 0; }
+
+SuscriptorMemoria::SuscriptorMemoria(const char* nombreSegmento, bool)
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), capacidad(0),
+      cursor(0), perdidos(0), bytesMapeados(0) {
+    std::cerr << "Memoria compartida no disponible en Windows (" << nombreSegmento << ")" << std::endl;
+}
+SuscriptorMemoria::~SuscriptorMemoria() {}
+bool SuscriptorMemoria::estaConectado() const { return false; }
+bool SuscriptorMemoria::leer(RegistroDecodificado&) { return false; }
+bool SuscriptorMemoria::escritorActivo() const { return false; }
+uint64_t SuscriptorMemoria::getPerdidos() const { return 0; }
+
+#endif // _WIN32
@@ -0,0 +1,180 @@
+// ============================================================================
+// MemoriaCompartida.h - Difusión del Flujo Decodificado por Memoria Compartida
+// ============================================================================
+
+#ifndef MEMORIA_COMPARTIDA_H
+#define MEMORIA_COMPARTIDA_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "ObservadorCarga.h"
+
+/**
+ * @struct RegistroDecodificado
+ * @brief Un evento del flujo decodificado, tal como lo ve un suscriptor
+ */
+struct RegistroDecodificado {
+    uint64_t numero;        ///< Número de registro (0, 1, 2, ...)
+    uint64_t marcaTiempoNs; ///< CLOCK_REALTIME en nanosegundos
+    uint64_t indiceTrama;   ///< Trama que produjo el evento
+    char tipo;              ///< 'L' (carácter decodificado) o 'M' (rotación)
+    char dato;              ///< Carácter decodificado (tipo 'L')
+    int32_t rotacion;       ///< Rotación aplicada (tipo 'M')
+};
+
+/**
+ * @struct RanuraAnillo
+ * @brief Ranura del anillo en memoria compartida (32 bytes, 2 por línea)
+ * 
+ * 'secuencia' funciona como seqlock por ranura: vale 0 mientras el
+ * escritor la modifica y numero + 1 cuando el contenido es válido.
+ */
+struct RanuraAnillo {
+    std::atomic<uint64_t> secuencia;    ///< numero + 1, o 0 si se está escribiendo
+    std::atomic<uint64_t> marcaTiempo;  ///< CLOCK_REALTIME en nanosegundos
+    std::atomic<uint64_t> indiceTrama;  ///< Trama que produjo el evento
+    std::atomic<uint64_t> carga;        ///< tipo | dato << 8 | rotacion << 32
+};
+
+/**
+ * @struct CabeceraAnillo
+ * @brief Cabecera del segmento compartido
+ */
+struct CabeceraAnillo {
+    uint32_t magia;                     ///< Identifica un segmento PRT-7
+    uint32_t version;                   ///< Versión del formato
+    uint64_t capacidad;                 ///< Ranuras (potencia de 2)
+    std::atomic<uint32_t> activo;       ///< 1 mientras el escritor publica
+    alignas(64) std::atomic<uint64_t> escritos; ///< Registros publicados en total
+};
+
+/**
+ * @class PublicadorMemoria
+ * @brief Escritor único del anillo en memoria compartida POSIX
+ * 
+ * Se engancha a ListaDeCarga como observador y publica cada carácter
+ * decodificado (y cada rotación) en un anillo creado con shm_open/mmap.
+ * Nunca espera a los lectores: si uno se atrasa más que la capacidad del
+ * anillo, sus registros se sobrescriben y él detecta el desborde.
+ * 
+ * Sólo disponible en sistemas POSIX; en Windows estaListo() es false.
+ */
+class PublicadorMemoria : public ObservadorCarga {
+public:
+    static const uint64_t MAX_CAPACIDAD = 1ull << 26;  ///< Ranuras como máximo (2 GB de segmento)
+
+private:
+    char nombre[128];           ///< Nombre del segmento (ej: "/prt7")
+    CabeceraAnillo* cabecera;   ///< Cabecera mapeada
+    RanuraAnillo* ranuras;      ///< Ranuras mapeadas
+    uint64_t mascara;           ///< capacidad - 1
+    uint64_t siguiente;         ///< Próximo número de registro (sólo el escritor)
+    size_t bytesMapeados;       ///< Tamaño del mapeo
+    
+    /**
+     * @brief Escribe un registro en su ranura y lo hace visible
+     */
+    void publicar(char tipo, char dato, int32_t rotacion, unsigned long indiceTrama);
+
+public:
+    /**
+     * @brief Constructor - Crea (o recrea) el segmento compartido
+     * @param nombreSegmento Nombre POSIX del segmento (ej: "/prt7")
+     * @param capacidad Ranuras del anillo (se redondea a potencia de 2;
+     *                  más de MAX_CAPACIDAD es un error)
+     */
+    PublicadorMemoria(const char* nombreSegmento, uint64_t capacidad);
+    
+    /**
+     * @brief Destructor - Marca el flujo como terminado y elimina el nombre
+     * 
+     * Los suscriptores que ya mapearon el segmento pueden terminar de leer.
+     */
+    ~PublicadorMemoria();
+    
+    /**
+     * @brief Indica si el segmento se creó correctamente
+     */
+    bool estaListo() const;
+    
+    /**
+     * @brief Publica un carácter decodificado
+     * @param dato Carácter insertado en la lista de carga
+     * @param indiceTrama Trama que lo produjo
+     */
+    void alInsertar(char dato, unsigned long indiceTrama) override;
+    
+    /**
+     * @brief Publica una rotación del rotor
+     * @param rotacion Posiciones rotadas
+     * @param indiceTrama Trama MAP que la produjo
+     */
+    void publicarRotacion(int rotacion, unsigned long indiceTrama);
+    
+    /**
+     * @brief Registros publicados hasta ahora
+     */
+    uint64_t getPublicados() const;
+};
+
+/**
+ * @class SuscriptorMemoria
+ * @brief Lector del anillo publicado por PublicadorMemoria
+ * 
+ * Mapea el segmento en sólo lectura y lleva su propio cursor. Puede
+ * conectarse y desconectarse en cualquier momento; lee los registros
+ * directamente de la memoria compartida, sin llamadas al kernel.
+ */
+class SuscriptorMemoria {
+private:
+    const CabeceraAnillo* cabecera; ///< Cabecera mapeada
+    const RanuraAnillo* ranuras;    ///< Ranuras mapeadas
+    uint64_t mascara;               ///< capacidad - 1
+    uint64_t capacidad;             ///< Ranuras del anillo
+    uint64_t cursor;                ///< Próximo registro a leer
+    uint64_t perdidos;              ///< Registros sobrescritos antes de leerlos
+    size_t bytesMapeados;           ///< Tamaño del mapeo
+
+public:
+    /**
+     * @brief Constructor - Se conecta a un segmento existente
+     * @param nombreSegmento Nombre POSIX del segmento
+     * @param desdeInicio true para empezar por el registro más antiguo
+     *                    disponible, false para leer sólo lo nuevo
+     */
+    SuscriptorMemoria(const char* nombreSegmento, bool desdeInicio);
+    
+    /**
+     * @brief Destructor - Desmapea el segmento
+     */
+    ~SuscriptorMemoria();
+    
+    /**
+     * @brief Indica si el segmento se mapeó correctamente
+     */
+    bool estaConectado() const;
+    
+    /**
+     * @brief Lee el siguiente registro, si hay
+     * @param reg Destino del registro
+     * @return true si se leyó un registro, false si no hay nuevos
+     * 
+     * Si el escritor dio la vuelta al anillo, el cursor salta al registro
+     * más antiguo aún válido y la diferencia se suma a getPerdidos().
+     */
+    bool leer(RegistroDecodificado& reg);
+    
+    /**
+     * @brief Indica si el escritor sigue publicando
+     */
+    bool escritorActivo() const;
+    
+    /**
+     * @brief Registros perdidos por desborde desde la conexión
+     */
+    uint64_t getPerdidos() const;
+};
+
+#endif // MEMORIA_COMPARTIDA_H
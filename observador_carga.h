@@ -0,0 +1,48 @@
+// ============================================================================
+// ObservadorCarga.h - Interfaz para Observar Caracteres Decodificados
+// ============================================================================
+
+#ifndef OBSERVADOR_CARGA_H
+#define OBSERVADOR_CARGA_H
+
+/**
+ * @class ObservadorCarga
+ * @brief Interfaz para etapas que consumen el flujo decodificado en vivo
+ * 
+ * ListaDeCarga notifica a sus observadores cada carácter en el momento
+ * en que se inserta, junto con el índice de la trama que lo produjo.
+ * Permite agregar etapas (búsqueda de patrones, publicación, etc.)
+ * sin esperar a imprimirMensaje().
+ * 
+ * Si un tramo ya insertado se re-decodifica (DecodificadorRetroactivo),
+ * la lista lo informa con alReescribir().
+ */
+class ObservadorCarga {
+public:
+    /**
+     * @brief Recibe un carácter recién decodificado
+     * @param dato Carácter insertado en la lista de carga
+     * @param indiceTrama Índice (base 1) de la trama que lo produjo
+     */
+    virtual void alInsertar(char dato, unsigned long indiceTrama) = 0;
+    
+    /**
+     * @brief Recibe un tramo final de la lista que se reescribió
+     * @param desde Posición (base 0) del primer carácter reescrito
+     * @param datos Nuevos caracteres, en orden de llegada
+     * @param cantidad Cantidad de caracteres reescritos
+     * 
+     * Por defecto no hace nada: sirve a las etapas que sólo reflejan el
+     * estado actual. Las que ya emitieron algo por cada carácter (alertas,
+     * registros difundidos) no pueden deshacerlo, y main no las combina
+     * con --correcciones.
+     */
+    virtual void alReescribir(unsigned long, const char*, int) {}
+    
+    /**
+     * @brief Destructor virtual para limpieza polimórfica correcta
+     */
+    virtual ~ObservadorCarga() {}
+};
+
+#endif // OBSERVADOR_CARGA_H
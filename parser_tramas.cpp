@@ -0,0 +1,77 @@
+// ============================================================================
+// ParserTramas.cpp - Implementación del Parser de Tramas
+// ============================================================================
+
+#include "ParserTramas.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+
+// Parsear línea -> trama
+TramaBase* parsearTrama(char* linea, bool estricto) {
+    if(!linea || linea[0] == '\0') return nullptr;
+    
+    // Prefijo opcional de secuencia: "S:"
+    bool conSecuencia = false;
+    unsigned long secuencia = 0;
+    
+    if(linea[0] >= '0' && linea[0] <= '9') {
+        char* fin;
+        secuencia = strtoul(linea, &fin, 10);
+        if(*fin != ':') return nullptr;
+        linea = fin + 1;
+        conSecuencia = true;
+    }
+    
+    char tipo = linea[0];
+    
+    // Validar formato básico
+    if(tipo != 'L' && tipo != 'M' && tipo != 'B') return nullptr;
+    if(linea[1] != ',') return nullptr;
+    
+    if(tipo == 'B') {
+        // Trama de carga masiva: B,N,XXXX
+        if(linea[2] < '0' || linea[2] > '9') return nullptr;
+        char* fin;
+        errno = 0;
+        unsigned long n = strtoul(&linea[2], &fin, 10);
+        if(*fin != ',' || errno == ERANGE || n > (unsigned long)TramaCargaMasiva::MAX_CARGA) return nullptr;
+        
+        const char* datos = fin + 1;
+        size_t disponibles = strlen(datos);
+        if(estricto && disponibles != n) return nullptr;
+        if(disponibles < n) n = disponibles;
+        
+        TramaBase* trama = new TramaCargaMasiva(datos, (int)n);
+        if(conSecuencia) trama->setSecuencia(secuencia);
+        return trama;
+    }
+    
+    if(estricto) {
+        if(tipo == 'L' && (linea[2] == '\0' || linea[3] != '\0')) return nullptr;
+        if(tipo == 'M') {
+            char* fin;
+            errno = 0;
+            long n = strtol(&linea[2], &fin, 10);
+            if(fin == &linea[2] || *fin != '\0' || errno == ERANGE) return nullptr;
+            if(n > 1000000 || n < -1000000) return nullptr;
+        }
+    }
+    
+    TramaBase* trama;
+    if(tipo == 'L') {
+        // Trama de carga: L,X
+        char caracter = linea[2];
+        trama = new TramaLoad(caracter);
+    } else {
+        // Trama de mapeo: M,N
+        int rotacion = atoi(&linea[2]);
+        trama = new TramaMap(rotacion);
+    }
+    
+    if(conSecuencia) trama->setSecuencia(secuencia);
+    return trama;
+}
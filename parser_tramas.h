@@ -0,0 +1,38 @@
+// ============================================================================
+// ParserTramas.h - Interpretación de Líneas del Protocolo PRT-7
+// ============================================================================
+
+#ifndef PARSER_TRAMAS_H
+#define PARSER_TRAMAS_H
+
+#include "TramaBase.h"
+
+/// Largo máximo de una línea del protocolo (una trama B completa con su secuencia)
+static const int LARGO_MAX_LINEA = 2048;
+
+/**
+ * @brief Parsea una línea de texto y crea la trama correspondiente
+ * @param linea Línea leída del puerto serial (ej: "L,A" o "M,5")
+ * @param estricto true para rechazar líneas que el modo tolerante acepta
+ * @return Puntero a TramaBase (TramaLoad, TramaMap o TramaCargaMasiva), o nullptr si hay error
+ * 
+ * Formato esperado:
+ * - "L,X" -> TramaLoad con carácter X
+ * - "M,N" -> TramaMap con rotación N
+ * - "B,N,XXXX" -> TramaCargaMasiva con los N caracteres XXXX
+ * 
+ * Todos los formatos aceptan un prefijo opcional "S:" con el número de
+ * secuencia de la trama (ej: "17:L,A", "18:M,-2"), usado para reordenar
+ * tramas que llegan por varios enlaces.
+ * 
+ * En modo tolerante (el histórico) sólo se miran el tipo y la coma: "L,"
+ * carga un '\0', "L,AB" carga 'A' y "M,x" rota 0. En modo estricto la
+ * carga debe ser exactamente un carácter y la rotación un entero completo.
+ * 
+ * En una trama B el largo N (hasta TramaCargaMasiva::MAX_CARGA) y su coma
+ * son obligatorios. En modo tolerante se toman los caracteres que haya,
+ * hasta N; en modo estricto la carga debe medir exactamente N.
+ */
+TramaBase* parsearTrama(char* linea, bool estricto = false);
+
+#endif // PARSER_TRAMAS_H
@@ -0,0 +1,228 @@
+// ============================================================================
+// PoolNodos.h - Pool de Nodos por Tipo (Losas + Lista Libre)
+// ============================================================================
+
+#ifndef POOL_NODOS_H
+#define POOL_NODOS_H
+
+#include <cstddef>
+
+/**
+ * @struct EstadisticasPool
+ * @brief Contadores de uso de un PoolNodos
+ */
+struct EstadisticasPool {
+    size_t vivos;               ///< Bloques entregados y no devueltos
+    size_t maxVivos;            ///< Máximo histórico de bloques vivos
+    size_t bytesReservados;     ///< Memoria pedida al sistema (losas)
+    size_t losas;               ///< Cantidad de losas reservadas
+};
+
+/**
+ * @class PoolNodos
+ * @brief Asignador de bloques de tamaño fijo para un tipo T
+ * 
+ * Reserva memoria en losas alineadas a línea de caché y entrega bloques
+ * consecutivos dentro de cada losa, de modo que los nodos creados uno
+ * tras otro quedan contiguos en memoria. Los bloques devueltos se reciclan
+ * mediante una lista libre intrusiva (sin malloc por nodo).
+ * 
+ * El tamaño de bloque se redondea a un divisor de la línea de caché (o a
+ * un múltiplo de ella), para que ningún nodo quede partido entre dos líneas.
+ * Las losas empiezan pequeñas y duplican su tamaño hasta 64 KB, así una
+ * estructura con pocos nodos (ej: una sesión corta) no reserva de más.
+ * 
+ * Se usa de dos formas:
+ * - Como miembro de una estructura (ListaDeCarga, RotorDeMapeo), que puede
+ *   liberar todas sus losas de una vez con liberarTodo().
+ * - Por hilo con delHilo(), para objetos que se crean y destruyen en el
+ *   mismo hilo (las tramas). No es seguro compartir una instancia entre hilos.
+ */
+template <typename T>
+class PoolNodos {
+private:
+    static const size_t LINEA_CACHE = 64;       ///< Tamaño de línea de caché
+    static const size_t BYTES_LOSA = 64 * 1024; ///< Tamaño por defecto de una losa
+    static const size_t BLOQUES_POR_HILO = 256; ///< Bloques por losa en los pools por hilo
+    
+    /**
+     * @struct Losa
+     * @brief Cabecera de una losa (ocupa la primera línea de caché)
+     */
+    struct Losa {
+        Losa* siguiente;    ///< Siguiente losa reservada
+        char* crudo;        ///< Puntero original devuelto por new[]
+    };
+    
+    /**
+     * @struct BloqueLibre
+     * @brief Enlace intrusivo de la lista libre
+     */
+    struct BloqueLibre {
+        BloqueLibre* siguiente; ///< Siguiente bloque libre
+    };
+    
+    size_t tamBloque;           ///< Tamaño de cada bloque (redondeado)
+    size_t bloquesPorLosa;      ///< Bloques de la próxima losa
+    size_t maxBloquesPorLosa;   ///< Tope de crecimiento de las losas
+    Losa* losas;                ///< Losas reservadas
+    char* libreActual;          ///< Próximo bloque sin usar de la losa actual
+    char* finActual;            ///< Fin de la losa actual
+    BloqueLibre* libres;        ///< Bloques devueltos, listos para reusar
+    EstadisticasPool stats;     ///< Contadores de uso
+    
+    /**
+     * @brief Calcula un tamaño de bloque que no cruce líneas de caché
+     */
+    static size_t calcularTamBloque() {
+        size_t t = sizeof(T) > sizeof(BloqueLibre) ? sizeof(T) : sizeof(BloqueLibre);
+        if(t > LINEA_CACHE) {
+            return (t + LINEA_CACHE - 1) / LINEA_CACHE * LINEA_CACHE;
+        }
+        size_t p = sizeof(void*);
+        while(p < t) p *= 2;
+        return p;
+    }
+    
+    /**
+     * @brief Reserva una losa nueva alineada a línea de caché
+     */
+    void nuevaLosa() {
+        size_t bytes = LINEA_CACHE + bloquesPorLosa * tamBloque;
+        char* crudo = new char[bytes + LINEA_CACHE];
+        
+        // Alinear el inicio de la losa a línea de caché
+        size_t desfase = (size_t)crudo % LINEA_CACHE;
+        char* base = crudo + (desfase ? LINEA_CACHE - desfase : 0);
+        
+        Losa* losa = reinterpret_cast<Losa*>(base);
+        losa->crudo = crudo;
+        losa->siguiente = losas;
+        losas = losa;
+        
+        libreActual = base + LINEA_CACHE;
+        finActual = libreActual + bloquesPorLosa * tamBloque;
+        
+        stats.losas++;
+        stats.bytesReservados += bytes + LINEA_CACHE;
+        
+        // Crecimiento geométrico hasta el tope
+        if(bloquesPorLosa * 2 <= maxBloquesPorLosa) bloquesPorLosa *= 2;
+    }
+
+public:
+    /**
+     * @brief Constructor - Crea un pool vacío (sin reservar memoria)
+     * @param bloques Bloques de la primera losa (0 = losas de 64 KB)
+     */
+    explicit PoolNodos(size_t bloques = 0)
+        : tamBloque(calcularTamBloque()), losas(nullptr), libreActual(nullptr),
+          finActual(nullptr), libres(nullptr) {
+        maxBloquesPorLosa = BYTES_LOSA / tamBloque;
+        if(maxBloquesPorLosa == 0) maxBloquesPorLosa = 1;
+        bloquesPorLosa = bloques ? bloques : maxBloquesPorLosa;
+        if(bloquesPorLosa > maxBloquesPorLosa) maxBloquesPorLosa = bloquesPorLosa;
+        stats.vivos = stats.maxVivos = stats.bytesReservados = stats.losas = 0;
+    }
+    
+    /**
+     * @brief Destructor - Devuelve todas las losas al sistema
+     */
+    ~PoolNodos() {
+        liberarTodo();
+    }
+    
+    PoolNodos(const PoolNodos&) = delete;
+    PoolNodos& operator=(const PoolNodos&) = delete;
+    
+    /**
+     * @brief Entrega un bloque para construir un T (con placement new)
+     * @return Memoria sin inicializar de tamaño suficiente para T
+     */
+    void* reservar() {
+        void* p;
+        if(libres) {
+            p = libres;
+            libres = libres->siguiente;
+        } else {
+            if(libreActual == finActual) nuevaLosa();
+            p = libreActual;
+            libreActual += tamBloque;
+        }
+        if(++stats.vivos > stats.maxVivos) stats.maxVivos = stats.vivos;
+        return p;
+    }
+    
+    /**
+     * @brief Devuelve un bloque al pool (el objeto ya debe estar destruido)
+     * @param p Bloque obtenido con reservar()
+     */
+    void liberar(void* p) {
+        if(!p) return;
+        BloqueLibre* b = static_cast<BloqueLibre*>(p);
+        b->siguiente = libres;
+        libres = b;
+        stats.vivos--;
+    }
+    
+    /**
+     * @brief Reserva y toca de antemano memoria para n bloques más
+     * @param n Bloques a dejar listos en la lista libre
+     * 
+     * Los bloques se encadenan en orden de dirección y se escriben uno a
+     * uno, así las páginas quedan asignadas (sin fallos de página al
+     * insertar) y los próximos reservar() siguen siendo contiguos.
+     */
+    void prereservar(size_t n) {
+        BloqueLibre* primero = nullptr;
+        BloqueLibre** fin = &primero;
+        for(size_t i = 0; i < n; i++) {
+            if(libreActual == finActual) nuevaLosa();
+            BloqueLibre* b = reinterpret_cast<BloqueLibre*>(libreActual);
+            libreActual += tamBloque;
+            *fin = b;
+            fin = &b->siguiente;
+        }
+        *fin = libres;
+        libres = primero;
+    }
+    
+    /**
+     * @brief Libera todas las losas de una sola vez
+     * 
+     * No ejecuta destructores: sólo es válido para tipos triviales o
+     * cuando los objetos ya se destruyeron.
+     */
+    void liberarTodo() {
+        while(losas) {
+            Losa* sig = losas->siguiente;
+            delete[] losas->crudo;
+            losas = sig;
+        }
+        libreActual = finActual = nullptr;
+        libres = nullptr;
+        stats.vivos = 0;
+        stats.bytesReservados = 0;
+        stats.losas = 0;
+    }
+    
+    /**
+     * @brief Contadores de uso del pool
+     */
+    const EstadisticasPool& getEstadisticas() const { return stats; }
+    
+    /**
+     * @brief Pool propio del hilo que llama
+     * 
+     * Cada hilo obtiene su instancia (con losas más pequeñas, pensadas
+     * para pocos objetos vivos a la vez, sin pasar de una losa de 64 KB
+     * para objetos grandes); los bloques deben liberarse en el mismo hilo
+     * que los reservó.
+     */
+    static PoolNodos& delHilo() {
+        static thread_local PoolNodos pool(BLOQUES_POR_HILO * sizeof(T) <= BYTES_LOSA ? BLOQUES_POR_HILO : 0);
+        return pool;
+    }
+};
+
+#endif // POOL_NODOS_H
@@ -0,0 +1,154 @@
+// ============================================================================
+// PoolTrabajo.cpp - Implementación del Pool con Robo de Trabajo
+// ============================================================================
+
+#include "PoolTrabajo.h"
+#include "Traza.h"
+
+// Trabajador que ejecuta el hilo actual (para que las subtareas vayan a su cola)
+static thread_local PoolTrabajo* poolDelHilo = nullptr;
+static thread_local int indiceDelHilo = -1;
+
+// Constructor
+PoolTrabajo::PoolTrabajo(int hilos)
+    : siguienteCola(0), pendientes(0), encoladas(0), dormidos(0), activo(true) {
+    if(hilos <= 0) hilos = (int)std::thread::hardware_concurrency();
+    if(hilos <= 0) hilos = 1;
+    numHilos = hilos;
+    
+    colas = new ColaDoble[numHilos];
+    for(int i = 0; i < numHilos; i++) {
+        colas[i].capacidad = 64;
+        colas[i].tareas = new Tarea[colas[i].capacidad];
+        colas[i].frente = colas[i].fondo = 0;
+        colas[i].ejecutadas = colas[i].robadas = 0;
+    }
+    
+    this->hilos = new std::thread[numHilos];
+    for(int i = 0; i < numHilos; i++) {
+        this->hilos[i] = std::thread(&PoolTrabajo::trabajar, this, i);
+    }
+}
+
+// Destructor
+PoolTrabajo::~PoolTrabajo() {
+    esperar();
+    {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        activo = false;
+    }
+    hayTrabajo.notify_all();
+    
+    for(int i = 0; i < numHilos; i++) hilos[i].join();
+    for(int i = 0; i < numHilos; i++) delete[] colas[i].tareas;
+    delete[] hilos;
+    delete[] colas;
+}
+
+// Agregar al fondo (crece duplicando el arreglo circular)
+void PoolTrabajo::empujar(int cola, const Tarea& t) {
+    ColaDoble& c = colas[cola];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    
+    if(c.fondo - c.frente == c.capacidad) {
+        Tarea* mayor = new Tarea[c.capacidad * 2];
+        for(size_t i = c.frente; i != c.fondo; i++) {
+            mayor[i & (c.capacidad * 2 - 1)] = c.tareas[i & (c.capacidad - 1)];
+        }
+        delete[] c.tareas;
+        c.tareas = mayor;
+        c.capacidad *= 2;
+    }
+    c.tareas[c.fondo & (c.capacidad - 1)] = t;
+    c.fondo++;
+}
+
+// Tomar del fondo de la cola propia (LIFO)
+bool PoolTrabajo::tomarPropia(int cola, Tarea& t) {
+    ColaDoble& c = colas[cola];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if(c.fondo == c.frente) return false;
+    c.fondo--;
+    t = c.tareas[c.fondo & (c.capacidad - 1)];
+    return true;
+}
+
+// Robar del frente de otra cola (FIFO)
+bool PoolTrabajo::robar(int cola, Tarea& t) {
+    ColaDoble& c = colas[cola];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if(c.fondo == c.frente) return false;
+    t = c.tareas[c.frente & (c.capacidad - 1)];
+    c.frente++;
+    return true;
+}
+
+// Enviar tarea
+void PoolTrabajo::enviar(FuncionTarea funcion, void* arg) {
+    Tarea t = { funcion, arg };
+    pendientes++;
+    
+    int cola = (poolDelHilo == this) ? indiceDelHilo
+                                     : (int)(siguienteCola++ % (unsigned)numHilos);
+    empujar(cola, t);
+    encoladas++;
+    
+    // Despertar a alguien sólo si hay trabajadores dormidos
+    if(dormidos.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        hayTrabajo.notify_one();
+    }
+}
+
+// Esperar a que todo termine
+void PoolTrabajo::esperar() {
+    std::unique_lock<std::mutex> lock(mutexEspera);
+    terminado.wait(lock, [this] { return pendientes.load() == 0; });
+}
+
+// Bucle de un trabajador
+void PoolTrabajo::trabajar(int indice) {
+    poolDelHilo = this;
+    indiceDelHilo = indice;
+    TRAZA_HILO("trabajo");
+    unsigned semilla = 2463534242u + (unsigned)indice * 977u;
+    
+    while(true) {
+        Tarea t;
+        bool hay = tomarPropia(indice, t);
+        bool robada = false;
+        
+        // Sin trabajo propio: recorrer las demás colas desde una al azar
+        if(!hay && numHilos > 1) {
+            semilla ^= semilla << 13;
+            semilla ^= semilla >> 17;
+            semilla ^= semilla << 5;
+            int inicio = (int)(semilla % (unsigned)numHilos);
+            for(int k = 0; k < numHilos && !hay; k++) {
+                int victima = (inicio + k) % numHilos;
+                if(victima != indice) hay = robar(victima, t);
+            }
+            robada = hay;
+        }
+        
+        if(hay) {
+            encoladas--;
+            t.funcion(t.arg);
+            colas[indice].ejecutadas++;
+            if(robada) colas[indice].robadas++;
+            
+            if(--pendientes == 0) {
+                std::lock_guard<std::mutex> lock(mutexEspera);
+                terminado.notify_all();
+            }
+            continue;
+        }
+        
+        // Dormir hasta que se encole algo (o se detenga el pool)
+        std::unique_lock<std::mutex> lock(mutexEspera);
+        dormidos++;
+        hayTrabajo.wait(lock, [this] { return !activo || encoladas.load() > 0; });
+        dormidos--;
+        if(!activo) return;
+    }
+}
@@ -0,0 +1,135 @@
+// ============================================================================
+// PoolTrabajo.h - Pool de Hilos con Robo de Trabajo
+// ============================================================================
+
+#ifndef POOL_TRABAJO_H
+#define POOL_TRABAJO_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * @brief Función que ejecuta una tarea
+ * @param arg Argumento registrado junto con la tarea
+ */
+typedef void (*FuncionTarea)(void* arg);
+
+/**
+ * @class PoolTrabajo
+ * @brief Hilos trabajadores con una cola doble (deque) cada uno
+ * 
+ * Cada trabajador toma tareas del fondo de su propia cola (la última que
+ * agregó, todavía caliente en caché) y, cuando se queda sin trabajo, roba
+ * del frente de la cola de otro trabajador elegido al azar (la tarea más
+ * antigua, normalmente la más grande). Así las cargas muy desparejas se
+ * reparten solas sin un planificador central.
+ * 
+ * Una tarea puede enviar nuevas tareas: desde un trabajador van a su
+ * propia cola; desde fuera del pool se reparten en ronda.
+ */
+class PoolTrabajo {
+private:
+    /**
+     * @struct Tarea
+     * @brief Unidad de trabajo
+     */
+    struct Tarea {
+        FuncionTarea funcion;   ///< Qué ejecutar
+        void* arg;              ///< Con qué argumento
+    };
+    
+    /**
+     * @struct ColaDoble
+     * @brief Deque circular de un trabajador, protegida por su mutex
+     */
+    struct ColaDoble {
+        std::mutex mutex;       ///< Dueño y ladrones se turnan
+        Tarea* tareas;          ///< Arreglo circular (capacidad potencia de 2)
+        size_t capacidad;       ///< Tamaño del arreglo
+        size_t frente;          ///< Índice de la tarea más antigua
+        size_t fondo;           ///< Índice tras la tarea más reciente
+        unsigned long ejecutadas;   ///< Tareas corridas por este trabajador
+        unsigned long robadas;      ///< De ellas, cuántas fueron robadas
+    };
+    
+    int numHilos;                       ///< Cantidad de trabajadores
+    ColaDoble* colas;                   ///< Una cola por trabajador
+    std::thread* hilos;                 ///< Trabajadores
+    std::atomic<unsigned> siguienteCola;///< Ronda para envíos externos
+    std::atomic<long> pendientes;       ///< Tareas enviadas y no terminadas
+    std::atomic<long> encoladas;        ///< Tareas esperando en alguna cola
+    std::atomic<int> dormidos;          ///< Trabajadores esperando trabajo
+    std::atomic<bool> activo;           ///< false para terminar
+    std::mutex mutexEspera;             ///< Para dormir y despertar
+    std::condition_variable hayTrabajo; ///< Señal a trabajadores dormidos
+    std::condition_variable terminado;  ///< Señal a esperar()
+    
+    /**
+     * @brief Agrega una tarea al fondo de una cola
+     */
+    void empujar(int cola, const Tarea& t);
+    
+    /**
+     * @brief Saca la tarea más reciente de la cola propia
+     */
+    bool tomarPropia(int cola, Tarea& t);
+    
+    /**
+     * @brief Saca la tarea más antigua de la cola de otro
+     */
+    bool robar(int cola, Tarea& t);
+    
+    /**
+     * @brief Cuerpo de un trabajador
+     * @param indice Índice del trabajador
+     */
+    void trabajar(int indice);
+
+public:
+    /**
+     * @brief Constructor - Lanza los trabajadores
+     * @param hilos Cantidad de trabajadores (0 = uno por núcleo)
+     */
+    explicit PoolTrabajo(int hilos);
+    
+    /**
+     * @brief Destructor - Espera las tareas pendientes y detiene los hilos
+     */
+    ~PoolTrabajo();
+    
+    PoolTrabajo(const PoolTrabajo&) = delete;
+    PoolTrabajo& operator=(const PoolTrabajo&) = delete;
+    
+    /**
+     * @brief Envía una tarea al pool
+     * @param funcion Función a ejecutar
+     * @param arg Argumento de la función
+     */
+    void enviar(FuncionTarea funcion, void* arg);
+    
+    /**
+     * @brief Bloquea hasta que no queden tareas pendientes
+     * 
+     * Incluye las tareas que las propias tareas envían mientras tanto.
+     */
+    void esperar();
+    
+    /**
+     * @brief Cantidad de trabajadores
+     */
+    int getNumHilos() const { return numHilos; }
+    
+    /**
+     * @brief Tareas ejecutadas por un trabajador
+     */
+    unsigned long getEjecutadas(int indice) const { return colas[indice].ejecutadas; }
+    
+    /**
+     * @brief Tareas que un trabajador robó de otras colas
+     */
+    unsigned long getRobadas(int indice) const { return colas[indice].robadas; }
+};
+
+#endif // POOL_TRABAJO_H
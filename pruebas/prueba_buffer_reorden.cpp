@@ -0,0 +1,183 @@
+// ============================================================================
+// prueba_buffer_reorden.cpp - Pruebas de Comportamiento de BufferReorden
+// ============================================================================
+// Alimenta la ventana con tramas secuenciadas fuera de orden y un reloj
+// simulado: entrega inmediata de rachas contiguas, hueco que se salta al
+// vencer el timeout (y no antes), tramas tardías y duplicadas, avance
+// forzado por una secuencia fuera de la ventana (también muy lejana, hasta
+// ULONG_MAX) y vaciado final. Termina con código distinto de cero si
+// alguna verificación falla.
+//
+// Uso:
+//   prueba_buffer_reorden
+// ============================================================================
+
+#include "verificacion.h"
+#include "BufferReorden.h"
+#include "TramaLoad.h"
+#include <climits>
+
+/**
+ * @struct Recibidas
+ * @brief Secuencias entregadas por la ventana, en orden
+ */
+struct Recibidas {
+    unsigned long secuencias[64];
+    int cantidad;
+};
+
+// Receptor: anota la secuencia y libera la trama
+static void anotar(TramaBase* trama, void* ctx) {
+    Recibidas* r = (Recibidas*)ctx;
+    if(r->cantidad < 64) r->secuencias[r->cantidad] = trama->getSecuencia();
+    r->cantidad++;
+    delete trama;
+}
+
+// Trama L con secuencia
+static TramaBase* trama(unsigned long secuencia) {
+    TramaBase* t = new TramaLoad('A');
+    t->setSecuencia(secuencia);
+    return t;
+}
+
+// Las entregas hasta ahora son exactamente 'esperadas'
+static bool entregadasSon(const Recibidas& r, const unsigned long* esperadas, int n) {
+    if(r.cantidad != n) return false;
+    for(int i = 0; i < n; i++) {
+        if(r.secuencias[i] != esperadas[i]) return false;
+    }
+    return true;
+}
+
+// Hueco, tardías, duplicadas y avance forzado en una misma ventana
+static void probarHuecos() {
+    BufferReorden buffer(8, 50, 1);
+    Recibidas r = { {}, 0 };
+    
+    buffer.insertar(trama(1), 0, anotar, &r);
+    verificar(r.cantidad == 1, "la secuencia esperada se entrega enseguida");
+    
+    // Falta la 2: la 3 y la 4 quedan retenidas
+    buffer.insertar(trama(3), 0, anotar, &r);
+    buffer.insertar(trama(4), 10, anotar, &r);
+    verificar(r.cantidad == 1, "las tramas detrás de un hueco quedan retenidas");
+    
+    // El hueco empezó en t=0: no vence a los 49 ms, sí a los 50
+    buffer.avanzar(49, anotar, &r);
+    verificar(r.cantidad == 1 && buffer.getPerdidas() == 0, "el hueco no vence antes del timeout");
+    buffer.avanzar(50, anotar, &r);
+    const unsigned long trasHueco[] = { 1, 3, 4 };
+    verificar(entregadasSon(r, trasHueco, 3), "al vencer el hueco se entregan 3 y 4");
+    verificar(buffer.getPerdidas() == 1, "la secuencia 2 cuenta como perdida");
+    
+    // La 2 llega tarde; la 5 dos veces
+    buffer.insertar(trama(2), 60, anotar, &r);
+    buffer.insertar(trama(5), 60, anotar, &r);
+    buffer.insertar(trama(5), 60, anotar, &r);
+    verificar(r.cantidad == 4 && buffer.getDescartadas() == 2, "tardía y repetida se descartan");
+    
+    // Duplicada mientras espera en la ventana
+    buffer.insertar(trama(7), 70, anotar, &r);
+    buffer.insertar(trama(7), 70, anotar, &r);
+    verificar(buffer.getDescartadas() == 3, "una duplicada retenida se descarta");
+    buffer.insertar(trama(6), 75, anotar, &r);
+    const unsigned long trasSeis[] = { 1, 3, 4, 5, 6, 7 };
+    verificar(entregadasSon(r, trasSeis, 6), "la 6 libera la racha 6, 7");
+    
+    // Fuera de la ventana (esperada 8, ventana 8): se saltan 8..12
+    buffer.insertar(trama(20), 80, anotar, &r);
+    verificar(r.cantidad == 6 && buffer.getPerdidas() == 6, "una secuencia lejana fuerza el avance");
+    
+    // Al terminar, lo retenido sale aunque haya huecos
+    buffer.vaciar(anotar, &r);
+    const unsigned long final_[] = { 1, 3, 4, 5, 6, 7, 20 };
+    verificar(entregadasSon(r, final_, 7), "vaciar entrega la 20");
+    verificar(buffer.getPerdidas() == 13, "13..19 también cuentan como perdidas");
+    verificar(buffer.getEntregadas() == 7, "contador de entregadas");
+    verificar(buffer.getMaxRetenidas() == 2, "ocupación máxima");
+}
+
+// Cada hueco nuevo reinicia el conteo del timeout
+static void probarTimeoutPorHueco() {
+    BufferReorden buffer(16, 100, 0);
+    Recibidas r = { {}, 0 };
+    
+    buffer.insertar(trama(0), 0, anotar, &r);
+    buffer.insertar(trama(2), 0, anotar, &r);      // Hueco en 1 desde t=0
+    buffer.insertar(trama(4), 90, anotar, &r);
+    buffer.avanzar(100, anotar, &r);                // Salta 1, entrega 2; hueco en 3 desde t=100
+    const unsigned long primero[] = { 0, 2 };
+    verificar(entregadasSon(r, primero, 2), "vencido el primer hueco sólo sale la 2");
+    
+    buffer.avanzar(199, anotar, &r);
+    verificar(r.cantidad == 2, "el segundo hueco cuenta desde que quedó expuesto");
+    buffer.avanzar(200, anotar, &r);
+    const unsigned long segundo[] = { 0, 2, 4 };
+    verificar(entregadasSon(r, segundo, 3), "vencido el segundo hueco sale la 4");
+    verificar(buffer.getPerdidas() == 2, "se perdieron la 1 y la 3");
+    
+    // Sin huecos no hay nada que vencer
+    buffer.avanzar(100000, anotar, &r);
+    verificar(r.cantidad == 3 && buffer.getPerdidas() == 2, "avanzar sin retenidas no hace nada");
+}
+
+// La primera trama alinea la ventana con el emisor
+static void probarAlineacion() {
+    BufferReorden buffer(8, 50, 0);
+    Recibidas r = { {}, 0 };
+    
+    buffer.insertar(trama(1000), 0, anotar, &r);
+    buffer.insertar(trama(1001), 0, anotar, &r);
+    verificar(r.cantidad == 2 && buffer.getPerdidas() == 0, "la ventana se alinea con la primera secuencia");
+}
+
+// Un salto enorme entrega lo retenido y cuenta el hueco de una vez
+static void probarSaltoLejano() {
+    BufferReorden buffer(8, 50, 0);
+    Recibidas r = { {}, 0 };
+    
+    buffer.insertar(trama(0), 0, anotar, &r);
+    buffer.insertar(trama(2), 0, anotar, &r);
+    buffer.insertar(trama(3), 0, anotar, &r);
+    buffer.insertar(trama(3000000000UL), 10, anotar, &r);
+    const unsigned long lejos[] = { 0, 2, 3 };
+    verificar(entregadasSon(r, lejos, 3), "el salto entrega primero lo retenido");
+    verificar(buffer.getPerdidas() == 2999999990UL, "la 1 y 4..2999999992 cuentan como perdidas");
+    buffer.vaciar(anotar, &r);
+    const unsigned long final_[] = { 0, 2, 3, 3000000000UL };
+    verificar(entregadasSon(r, final_, 4), "vaciar entrega la trama lejana");
+    verificar(buffer.getPerdidas() == 2999999997UL, "perdidas + entregadas cubren 0..3000000000");
+    
+    // En el extremo del rango de secuencias
+    BufferReorden extremo(8, 50, 0);
+    Recibidas e = { {}, 0 };
+    extremo.insertar(trama(0), 0, anotar, &e);
+    extremo.insertar(trama(ULONG_MAX), 0, anotar, &e);
+    verificar(e.cantidad == 1 && extremo.getPerdidas() == ULONG_MAX - 8, "salto hasta ULONG_MAX");
+    extremo.vaciar(anotar, &e);
+    verificar(e.cantidad == 2 && e.secuencias[1] == ULONG_MAX, "vaciar entrega la secuencia ULONG_MAX");
+}
+
+// Las tramas que siguen retenidas se liberan con la ventana
+static void probarDestructor() {
+    Recibidas r = { {}, 0 };
+    {
+        BufferReorden buffer(8, 50, 0);
+        buffer.insertar(trama(3), 0, anotar, &r);
+        buffer.insertar(trama(5), 0, anotar, &r);
+    }
+    verificar(r.cantidad == 0, "el destructor no entrega lo retenido");
+}
+
+int main() {
+    TramaBase::setDetalle(false);
+    
+    probarHuecos();
+    probarTimeoutPorHueco();
+    probarAlineacion();
+    probarSaltoLejano();
+    probarDestructor();
+    
+    return terminarPruebas("buffer_reorden");
+}
@@ -0,0 +1,206 @@
+// ============================================================================
+// prueba_buscador_patrones.cpp - Pruebas de Comportamiento de BuscadorPatrones
+// ============================================================================
+// Compila el autómata Aho-Corasick con patrones que se solapan, son
+// prefijo o sufijo de otros o se repiten, y compara cada coincidencia
+// (patrón, posición, trama) con las que se obtienen buscando cada patrón
+// a mano. Revisa también el enganche como observador de ListaDeCarga
+// (caracteres sueltos y bloques), reiniciar() y la lectura del archivo
+// de patrones (comentarios, CRLF y líneas demasiado largas).
+//
+// Uso:
+//   prueba_buscador_patrones
+// ============================================================================
+
+#include "verificacion.h"
+#include "BuscadorPatrones.h"
+#include "ListaDeCarga.h"
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+static const int MAX_EVENTOS = 256;
+
+/**
+ * @struct Eventos
+ * @brief Coincidencias recibidas por el manejador
+ */
+struct Eventos {
+    int patron[MAX_EVENTOS];
+    unsigned long posicion[MAX_EVENTOS];
+    unsigned long trama[MAX_EVENTOS];
+    int cantidad;
+};
+
+// Manejador: anota cada coincidencia
+static void anotar(const Coincidencia& c, void* ctx) {
+    Eventos* e = (Eventos*)ctx;
+    if(e->cantidad < MAX_EVENTOS) {
+        e->patron[e->cantidad] = c.patron;
+        e->posicion[e->cantidad] = c.posicion;
+        e->trama[e->cantidad] = c.indiceTrama;
+    }
+    e->cantidad++;
+}
+
+// ¿El evento (patrón, posición) está entre los recibidos?
+static bool recibido(const Eventos& e, int patron, unsigned long posicion) {
+    for(int i = 0; i < e.cantidad && i < MAX_EVENTOS; i++) {
+        if(e.patron[i] == patron && e.posicion[i] == posicion) return true;
+    }
+    return false;
+}
+
+// Comparar contra la búsqueda ingenua de cada patrón en el texto
+static void compararConIngenua(const char* const* patrones, int n, const char* texto,
+                               const char* caso) {
+    BuscadorPatrones buscador;
+    Eventos e = { {}, {}, {}, 0 };
+    buscador.setManejador(anotar, &e);
+    verificar(buscador.compilar(patrones, n), caso, "compilar");
+    
+    int largo = (int)strlen(texto);
+    for(int i = 0; i < largo; i++) buscador.alInsertar(texto[i], (unsigned long)(i + 1));
+    
+    int esperadas = 0;
+    bool todas = true;
+    for(int p = 0; p < n; p++) {
+        int lp = (int)strlen(patrones[p]);
+        for(int fin = lp - 1; fin < largo; fin++) {
+            if(lp > 0 && memcmp(texto + fin - lp + 1, patrones[p], lp) == 0) {
+                esperadas++;
+                if(!recibido(e, p, (unsigned long)fin)) todas = false;
+            }
+        }
+    }
+    verificar(e.cantidad == esperadas, caso, "misma cantidad de coincidencias que la búsqueda ingenua");
+    verificar(todas, caso, "cada coincidencia ingenua se reporta en su posición");
+    verificar(buscador.getTotalCoincidencias() == (unsigned long)esperadas, caso, "contador de coincidencias");
+    
+    bool tramas = true;
+    for(int i = 0; i < e.cantidad && i < MAX_EVENTOS; i++) {
+        if(e.trama[i] != e.posicion[i] + 1) tramas = false;
+    }
+    verificar(tramas, caso, "la trama informada es la del último carácter");
+}
+
+// Patrones clásicos y casos borde del autómata
+static void probarAutomata() {
+    const char* clasicos[] = { "HE", "SHE", "HIS", "HERS" };
+    compararConIngenua(clasicos, 4, "USHERS AHISHERS SHE HE", "he/she/his/hers");
+    
+    const char* solapados[] = { "A", "AA", "AAA" };
+    compararConIngenua(solapados, 3, "AAAAAB AA", "repeticiones");
+    
+    const char* repetidos[] = { "SOS", "SOS", "OS" };
+    compararConIngenua(repetidos, 3, "SOSOSOS", "patrón repetido");
+    
+    const char* altos[] = { "\xC3\xB1", "A\xFF" };
+    compararConIngenua(altos, 2, "ma\xC3\xB1" "ana A\xFF\xFF", "bytes altos");
+    
+    const char* ninguno[] = { "XYZ" };
+    compararConIngenua(ninguno, 1, "XYXYXZ", "sin coincidencias");
+    
+    // Sin patrones no se reporta nada
+    BuscadorPatrones vacio;
+    Eventos e = { {}, {}, {}, 0 };
+    vacio.setManejador(anotar, &e);
+    vacio.compilar(nullptr, 0);
+    vacio.alInsertar('A', 1);
+    verificar(e.cantidad == 0 && vacio.getNumPatrones() == 0, "sin patrones no hay coincidencias");
+    
+    // reiniciar() olvida el prefijo parcial y la posición
+    BuscadorPatrones buscador;
+    const char* uno[] = { "HOLA" };
+    buscador.compilar(uno, 1);
+    buscador.setManejador(anotar, &e);
+    const char* antes = "HO";
+    for(int i = 0; antes[i]; i++) buscador.alInsertar(antes[i], 1);
+    buscador.reiniciar();
+    const char* despues = "LAHOLA";
+    for(int i = 0; despues[i]; i++) buscador.alInsertar(despues[i], 2);
+    verificar(e.cantidad == 1 && e.posicion[0] == 5, "reiniciar vuelve al estado y la posición iniciales");
+}
+
+// Enganchado a ListaDeCarga: caracteres sueltos y bloques
+static void probarObservador() {
+    ListaDeCarga lista;
+    BuscadorPatrones buscador;
+    Eventos e = { {}, {}, {}, 0 };
+    const char* patrones[] = { "ALERTA", "TA" };
+    buscador.compilar(patrones, 2);
+    buscador.setManejador(anotar, &e);
+    verificar(lista.agregarObservador(&buscador), "registrar el buscador como observador");
+    
+    lista.setTramaActual(1);
+    lista.insertarAlFinal('A');
+    lista.setTramaActual(2);
+    lista.insertarBloque("LER", 3);
+    lista.setTramaActual(3);
+    lista.insertarBloque("TA!", 3);
+    
+    verificar(e.cantidad == 2, "un bloque avanza el autómata carácter por carácter");
+    verificar(recibido(e, 0, 5) && recibido(e, 1, 5), "ALERTA y TA terminan en la posición 5");
+    verificar(e.trama[0] == 3 && e.trama[1] == 3, "la coincidencia lleva la trama que la completó");
+}
+
+// Escribir un archivo temporal con el contenido dado
+static bool escribirArchivo(const char* ruta, const char* contenido) {
+    FILE* f = fopen(ruta, "wb");
+    if(!f) return false;
+    fputs(contenido, f);
+    fclose(f);
+    return true;
+}
+
+// Archivo de patrones: comentarios, vacías, CRLF y largo máximo
+static void probarArchivo() {
+    char ruta[] = "/tmp/prueba_patrones.XXXXXX";
+    int fd = mkstemp(ruta);
+    if(fd < 0) {
+        verificar(false, "crear el archivo temporal de patrones");
+        return;
+    }
+    close(fd);
+    
+    char contenido[2 * BuscadorPatrones::MAX_PATRON + 64];
+    BuscadorPatrones buscador;
+    Eventos e = { {}, {}, {}, 0 };
+    buscador.setManejador(anotar, &e);
+    
+    escribirArchivo(ruta, "# comentario\n\nHOLA\r\nMUNDO\nULTIMA");
+    verificar(buscador.cargarArchivo(ruta), "archivo con comentarios y CRLF");
+    verificar(buscador.getNumPatrones() == 3, "se ignoran comentarios y líneas vacías");
+    const char* texto = "HOLA MUNDO ULTIMA";
+    for(int i = 0; texto[i]; i++) buscador.alInsertar(texto[i], 1);
+    verificar(e.cantidad == 3, "el CR no queda dentro del patrón");
+    
+    // Justo en el máximo: un solo patrón
+    int n = BuscadorPatrones::MAX_PATRON;
+    memset(contenido, 'Z', n);
+    strcpy(contenido + n, "\r\nOTRO\n");
+    escribirArchivo(ruta, contenido);
+    verificar(buscador.cargarArchivo(ruta) && buscador.getNumPatrones() == 2,
+              "un patrón de MAX_PATRON caracteres entra entero");
+    
+    // Uno más: error, no varios patrones partidos
+    memset(contenido, 'Z', n + 1);
+    strcpy(contenido + n + 1, "\nOTRO\n");
+    escribirArchivo(ruta, contenido);
+    verificar(!buscador.cargarArchivo(ruta), "una línea de MAX_PATRON + 1 caracteres es un error");
+    
+    memset(contenido, 'Z', 2 * n);
+    contenido[2 * n] = '\0';
+    escribirArchivo(ruta, contenido);
+    verificar(!buscador.cargarArchivo(ruta), "una línea del doble del máximo es un error");
+    
+    verificar(!buscador.cargarArchivo("/nonexistent/patrones.txt"), "un archivo inexistente es un error");
+    unlink(ruta);
+}
+
+int main() {
+    probarAutomata();
+    probarObservador();
+    probarArchivo();
+    return terminarPruebas("buscador_patrones");
+}
@@ -0,0 +1,275 @@
+// ============================================================================
+// prueba_cache.cpp - Pruebas de Comportamiento de CacheDecodificacion
+// ============================================================================
+// Trabaja sobre un directorio temporal: fallo y acierto de una captura,
+// claves distintas al cambiar el contenido, el modo del parser o el
+// desplazamiento inicial, entradas dañadas o de otra versión del formato
+// que se tratan como fallo, la copia sin sendfile (salida en O_APPEND)
+// y desalojo LRU (un acierto renueva la entrada; usos dentro del mismo
+// segundo se ordenan por nanosegundos). Termina con código distinto de
+// cero si alguna verificación falla.
+//
+// Uso:
+//   prueba_cache
+// ============================================================================
+
+#include "verificacion.h"
+#include "CacheDecodificacion.h"
+#include "RotorDeMapeo.h"
+#include "TablaMapeo.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+static const long long SIN_LIMITE = 1LL << 30;
+
+// Ruta del archivo de una entrada (mismo esquema que la caché)
+static void rutaEntrada(const char* dir, const Huella128& clave, char* ruta, int max) {
+    char hex[33];
+    clave.aHex(hex);
+    snprintf(ruta, max, "%s/%s.prt7c", dir, hex);
+}
+
+// Buscar y dejar el mensaje en 'mensaje' (termina en '\0')
+static bool buscar(CacheDecodificacion& cache, const Huella128& clave,
+                   EntradaCache& entrada, char* mensaje, int max) {
+    FILE* f = tmpfile();
+    if(!f) return false;
+    bool hallada = cache.buscar(clave, entrada, fileno(f));
+    lseek(fileno(f), 0, SEEK_SET);
+    ssize_t n = read(fileno(f), mensaje, max - 1);
+    mensaje[n > 0 ? n : 0] = '\0';
+    fclose(f);
+    return hallada;
+}
+
+// Guardar un mensaje con estadísticas de prueba
+static bool guardar(CacheDecodificacion& cache, const Huella128& clave, const char* mensaje) {
+    EntradaCache e;
+    e.tramas = 7;
+    e.malformadas = 1;
+    e.caracteres = (long)strlen(mensaje);
+    return cache.guardar(clave, e, mensaje);
+}
+
+// Fijar la fecha de modificación de una entrada (orden LRU)
+static void envejecer(const char* ruta, long segundos) {
+    struct timeval tiempos[2];
+    gettimeofday(&tiempos[0], nullptr);
+    tiempos[0].tv_sec -= segundos;
+    tiempos[1] = tiempos[0];
+    utimes(ruta, tiempos);
+}
+
+// Acierto, fallo e invalidación por contenido y configuración
+static void probarAciertos(const char* dir, TablaMapeo& tabla) {
+    const char* captura = "L,H\nL,O\nM,3\nL,L\nL,A\n";
+    const char* otra = "L,H\nL,O\nM,4\nL,L\nL,A\n";
+    EntradaCache e;
+    char mensaje[256];
+    
+    CacheDecodificacion cache(dir, SIN_LIMITE, tabla, 0, false);
+    verificar(cache.estaLista(), "el directorio de la caché se crea");
+    
+    Huella128 clave = cache.clave(captura, strlen(captura));
+    verificar(!buscar(cache, clave, e, mensaje, sizeof(mensaje)), "una captura nueva es un fallo");
+    verificar(cache.getFallos() == 1 && cache.getAciertos() == 0, "contador de fallos");
+    
+    verificar(guardar(cache, clave, "HOLA"), "guardar publica la entrada");
+    verificar(buscar(cache, clave, e, mensaje, sizeof(mensaje)), "la misma captura es un acierto");
+    verificar(strcmp(mensaje, "HOLA") == 0, "el acierto copia el mensaje guardado");
+    verificar(e.tramas == 7 && e.malformadas == 1 && e.caracteres == 4, "el acierto trae las estadísticas");
+    verificar(cache.getAciertos() == 1, "contador de aciertos");
+    
+    // La clave depende de los bytes, no sólo del largo
+    Huella128 claveOtra = cache.clave(otra, strlen(otra));
+    verificar(!(claveOtra.alta == clave.alta && claveOtra.baja == clave.baja), "otro contenido, otra clave");
+    verificar(!buscar(cache, claveOtra, e, mensaje, sizeof(mensaje)), "otro contenido es un fallo");
+    
+    // Misma captura con otra configuración: otra firma, otra clave
+    CacheDecodificacion estricta(dir, SIN_LIMITE, tabla, 0, true);
+    Huella128 claveEstricta = estricta.clave(captura, strlen(captura));
+    verificar(!buscar(estricta, claveEstricta, e, mensaje, sizeof(mensaje)), "cambiar el modo del parser invalida");
+    
+    CacheDecodificacion desplazada(dir, SIN_LIMITE, tabla, 1, false);
+    Huella128 claveDesplazada = desplazada.clave(captura, strlen(captura));
+    verificar(!buscar(desplazada, claveDesplazada, e, mensaje, sizeof(mensaje)),
+              "cambiar el desplazamiento inicial invalida");
+    
+    // Un desplazamiento equivalente (una vuelta completa) comparte la entrada
+    CacheDecodificacion vuelta(dir, SIN_LIMITE, tabla, tabla.getTamanio(), false);
+    Huella128 claveVuelta = vuelta.clave(captura, strlen(captura));
+    verificar(buscar(vuelta, claveVuelta, e, mensaje, sizeof(mensaje)), "una vuelta completa es el mismo desplazamiento");
+}
+
+// Entradas que no se pueden usar cuentan como fallo
+static void probarDanadas(const char* dir, TablaMapeo& tabla) {
+    const char* truncada = "L,A\n";
+    const char* vieja = "L,B\n";
+    EntradaCache e;
+    char mensaje[256];
+    char ruta[1024];
+    
+    CacheDecodificacion cache(dir, SIN_LIMITE, tabla, 0, false);
+    
+    // Mensaje más corto que lo que dice la cabecera
+    Huella128 clave = cache.clave(truncada, strlen(truncada));
+    guardar(cache, clave, "ABCDEFGH");
+    rutaEntrada(dir, clave, ruta, sizeof(ruta));
+    struct stat st;
+    verificar(stat(ruta, &st) == 0, "la entrada está en <dir>/<clave>.prt7c");
+    verificar(truncate(ruta, st.st_size - 3) == 0, "truncar la entrada");
+    verificar(!buscar(cache, clave, e, mensaje, sizeof(mensaje)), "una entrada truncada es un fallo");
+    
+    // Entrada escrita por una versión anterior del formato
+    clave = cache.clave(vieja, strlen(vieja));
+    guardar(cache, clave, "B");
+    rutaEntrada(dir, clave, ruta, sizeof(ruta));
+    int fd = open(ruta, O_WRONLY);
+    unsigned int version = 1;
+    bool escrita = fd >= 0 && pwrite(fd, &version, sizeof(version), 4) == (ssize_t)sizeof(version);
+    if(fd >= 0) close(fd);
+    verificar(escrita, "reescribir la versión de la entrada");
+    verificar(!buscar(cache, clave, e, mensaje, sizeof(mensaje)), "una entrada de otra versión es un fallo");
+    
+    // Entrada de otra clave renombrada sobre ésta
+    Huella128 claveA = cache.clave("A", 1);
+    Huella128 claveB = cache.clave("B", 1);
+    guardar(cache, claveA, "A");
+    char rutaA[1024];
+    char rutaB[1024];
+    rutaEntrada(dir, claveA, rutaA, sizeof(rutaA));
+    rutaEntrada(dir, claveB, rutaB, sizeof(rutaB));
+    verificar(rename(rutaA, rutaB) == 0, "renombrar la entrada");
+    verificar(!buscar(cache, claveB, e, mensaje, sizeof(mensaje)), "una entrada con otra clave es un fallo");
+}
+
+// Desalojo LRU: se va la menos usada, no la más vieja
+static void probarDesalojo(const char* dir, TablaMapeo& tabla) {
+    char bloque[1001];
+    memset(bloque, 'X', 1000);
+    bloque[1000] = '\0';
+    const char* capturas[3] = { "L,1\n", "L,2\n", "L,3\n" };
+    Huella128 claves[3];
+    char rutas[3][1024];
+    EntradaCache e;
+    char mensaje[2048];
+    
+    {
+        CacheDecodificacion cache(dir, SIN_LIMITE, tabla, 0, false);
+        for(int i = 0; i < 3; i++) {
+            claves[i] = cache.clave(capturas[i], strlen(capturas[i]));
+            verificar(guardar(cache, claves[i], bloque), "guardar una entrada de 1000 caracteres");
+            rutaEntrada(dir, claves[i], rutas[i], sizeof(rutas[i]));
+        }
+        envejecer(rutas[0], 300);
+        envejecer(rutas[1], 200);
+        envejecer(rutas[2], 100);
+        
+        // Usar la más vieja la vuelve la más reciente
+        verificar(buscar(cache, claves[0], e, mensaje, sizeof(mensaje)), "acierto sobre la entrada más vieja");
+    }
+    
+    // Cabe sólo dos entradas: el desalojo baja del 90% quitando una
+    CacheDecodificacion chica(dir, 2500, tabla, 0, false);
+    chica.podar();
+    struct stat st;
+    verificar(stat(rutas[0], &st) == 0, "la entrada usada recién sobrevive");
+    verificar(stat(rutas[1], &st) != 0, "se desaloja la menos usada");
+    verificar(stat(rutas[2], &st) == 0, "la siguiente en antigüedad sobrevive");
+    verificar(!buscar(chica, claves[1], e, mensaje, sizeof(mensaje)), "la desalojada es un fallo");
+    verificar(buscar(chica, claves[2], e, mensaje, sizeof(mensaje)), "la que quedó es un acierto");
+}
+
+// Salida en O_APPEND: sendfile no la acepta y se copia con read/write
+static void probarCopiaSinSendfile(const char* dir, TablaMapeo& tabla) {
+    char mensaje[64 * 1024 + 100];
+    for(size_t i = 0; i < sizeof(mensaje) - 1; i++) mensaje[i] = (char)('A' + i % 26);
+    mensaje[sizeof(mensaje) - 1] = '\0';
+    
+    CacheDecodificacion cache(dir, SIN_LIMITE, tabla, 0, false);
+    Huella128 clave = cache.clave("L,Z\n", 4);
+    guardar(cache, clave, mensaje);
+    
+    FILE* f = tmpfile();
+    if(!f) {
+        verificar(false, "crear el archivo de salida");
+        return;
+    }
+    int fd = fileno(f);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_APPEND);
+    EntradaCache e;
+    verificar(cache.buscar(clave, e, fd), "acierto con la salida en O_APPEND");
+    
+    char* copia = new char[sizeof(mensaje)];
+    ssize_t n = pread(fd, copia, sizeof(mensaje), 0);
+    verificar(n == (ssize_t)sizeof(mensaje) - 1 && memcmp(copia, mensaje, n) == 0,
+              "la copia sin sendfile empieza después de la cabecera");
+    delete[] copia;
+    fclose(f);
+}
+
+// Fijar la fecha de modificación con nanosegundos
+static void fijarFecha(const char* ruta, time_t segundos, long nanosegundos) {
+    struct timespec tiempos[2];
+    tiempos[0].tv_sec = segundos;
+    tiempos[0].tv_nsec = nanosegundos;
+    tiempos[1] = tiempos[0];
+    utimensat(AT_FDCWD, ruta, tiempos, 0);
+}
+
+// Varios usos en el mismo segundo: se desaloja el de menos nanosegundos
+static void probarMismoSegundo(const char* dir, TablaMapeo& tabla) {
+    char bloque[1001];
+    memset(bloque, 'Y', 1000);
+    bloque[1000] = '\0';
+    const char* capturas[4] = { "L,5\n", "L,6\n", "L,7\n", "L,8\n" };
+    char rutas[4][1024];
+    time_t segundo = time(nullptr) - 60;
+    
+    {
+        CacheDecodificacion cache(dir, SIN_LIMITE, tabla, 0, false);
+        for(int i = 0; i < 4; i++) {
+            Huella128 clave = cache.clave(capturas[i], strlen(capturas[i]));
+            guardar(cache, clave, bloque);
+            rutaEntrada(dir, clave, rutas[i], sizeof(rutas[i]));
+            // La primera guardada es la usada más recientemente
+            fijarFecha(rutas[i], segundo, (4 - i) * 1000000L);
+        }
+    }
+    
+    // Caben sólo dos entradas: se desalojan las otras dos
+    CacheDecodificacion chica(dir, 3000, tabla, 0, false);
+    chica.podar();
+    struct stat st;
+    verificar(stat(rutas[0], &st) == 0 && stat(rutas[1], &st) == 0,
+              "en el mismo segundo sobreviven las de uso más reciente");
+    verificar(stat(rutas[2], &st) != 0 && stat(rutas[3], &st) != 0,
+              "en el mismo segundo se desalojan las de uso más antiguo");
+}
+
+int main() {
+    char base[] = "/tmp/prueba_cache.XXXXXX";
+    if(!mkdtemp(base)) {
+        std::cerr << "[ERROR] No se pudo crear el directorio temporal" << std::endl;
+        return 1;
+    }
+    
+    RotorDeMapeo rotor;
+    TablaMapeo tabla(&rotor);
+    char dir[512];
+    const char* casos[5] = { "aciertos", "danadas", "sin_sendfile", "desalojo", "mismo_segundo" };
+    for(int i = 0; i < 5; i++) {
+        // Un subdirectorio (que la caché crea) por caso
+        snprintf(dir, sizeof(dir), "%s/%s", base, casos[i]);
+        if(i == 0) probarAciertos(dir, tabla);
+        if(i == 1) probarDanadas(dir, tabla);
+        if(i == 2) probarCopiaSinSendfile(dir, tabla);
+        if(i == 3) probarDesalojo(dir, tabla);
+        if(i == 4) probarMismoSegundo(dir, tabla);
+        borrarDirectorio(dir);
+    }
+    rmdir(base);
+    return terminarPruebas("cache");
+}
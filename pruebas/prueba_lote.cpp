@@ -0,0 +1,248 @@
+// ============================================================================
+// prueba_lote.cpp - Pruebas de Comportamiento de DecodificadorLote
+// ============================================================================
+// Genera una captura de más de UMBRAL_GRANDE bytes (se parte en trozos y
+// pasa por las tres fases) y otra pequeña (se decodifica entera en un
+// grupo), con cargas L y B, rotaciones de cualquier signo y tamaño,
+// líneas inválidas, vacías, CRLF, demasiado largas y una última línea
+// sin '\n'. Cada resultado y cada fila del manifiesto debe coincidir con
+// decodificar la misma captura con una SesionDecodificador alimentada en
+// pedazos arbitrarios, con varios hilos y con uno, en modo tolerante y
+// estricto y con desplazamiento inicial. Termina con código distinto de
+// cero si alguna verificación falla.
+//
+// Uso:
+//   prueba_lote
+// ============================================================================
+
+#include "verificacion.h"
+#include "DecodificadorLote.h"
+#include "SesionDecodificador.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+static const size_t BYTES_GRANDE = (9 << 20) / 2;   // 4.5 MB: cinco trozos
+static const size_t BYTES_CHICA = 64 << 10;
+
+/**
+ * @struct Captura
+ * @brief Bytes de una captura generada
+ */
+struct Captura {
+    char* datos;
+    size_t bytes;
+};
+
+static unsigned long semilla = 12345;
+
+// Generador congruencial: la captura es la misma en cada ejecución
+static unsigned long aleatorio(unsigned long n) {
+    semilla = semilla * 6364136223846793005UL + 1442695040888963407UL;
+    return (semilla >> 33) % n;
+}
+
+// Agregar una línea (o un fragmento) a la captura
+static void agregar(Captura& c, const char* texto, size_t n) {
+    memcpy(c.datos + c.bytes, texto, n);
+    c.bytes += n;
+}
+
+// Captura con todos los tipos de línea, de al menos 'objetivo' bytes
+static Captura generar(size_t objetivo) {
+    Captura c = { new char[objetivo + 4 * LARGO_MAX_LINEA], 0 };
+    char linea[LARGO_MAX_LINEA + 64];
+    
+    while(c.bytes < objetivo) {
+        unsigned long tipo = aleatorio(100);
+        int n;
+        if(tipo < 55) {
+            n = snprintf(linea, sizeof(linea), "L,%c\n", (char)('A' + aleatorio(26)));
+        } else if(tipo < 70) {
+            n = snprintf(linea, sizeof(linea), "M,%ld\n", (long)aleatorio(121) - 60);
+        } else if(tipo < 85) {
+            int largo = 1 + (int)aleatorio(40);
+            n = snprintf(linea, sizeof(linea), "B,%d,", largo);
+            for(int i = 0; i < largo; i++) linea[n++] = (char)('a' + aleatorio(26));
+            linea[n++] = '\n';
+        } else if(tipo < 90) {
+            // Inválidas en los dos modos, o sólo en el estricto
+            const char* malas[] = { "L,\n", "X,3\n", "M,abc\n", "L,AB\n", "M,+5 \n", "B,3,AB\n" };
+            n = snprintf(linea, sizeof(linea), "%s", malas[aleatorio(6)]);
+        } else if(tipo < 94) {
+            n = snprintf(linea, sizeof(linea), "\n");
+        } else if(tipo < 99) {
+            n = snprintf(linea, sizeof(linea), "L,%c\r\n", (char)('A' + aleatorio(26)));
+        } else {
+            // Más larga que LARGO_MAX_LINEA: se descarta entera
+            n = LARGO_MAX_LINEA + 10;
+            memset(linea, 'L', n);
+            linea[n++] = '\n';
+        }
+        agregar(c, linea, (size_t)n);
+    }
+    agregar(c, "L,Q", 3);
+    return c;
+}
+
+// Escribir una captura en disco
+static bool escribirCaptura(const char* ruta, const Captura& c) {
+    FILE* f = fopen(ruta, "wb");
+    if(!f) return false;
+    bool ok = fwrite(c.datos, 1, c.bytes, f) == c.bytes;
+    fclose(f);
+    return ok;
+}
+
+/**
+ * @struct Referencia
+ * @brief Resultado de decodificar la captura con una sesión
+ */
+struct Referencia {
+    char* mensaje;
+    long caracteres;
+    unsigned long tramas;
+    unsigned long malformadas;
+};
+
+// Decodificar con SesionDecodificador en pedazos de 4093 bytes
+static Referencia referencia(const Captura& c, const char* almacen, int desplazamiento, bool estricto) {
+    SesionDecodificador sesion;
+    sesion.configurar(desplazamiento, estricto);
+    sesion.getCarga().usarArchivo(almacen);     // Millones de caracteres: sin nodos
+    for(size_t i = 0; i < c.bytes; i += 4093) {
+        size_t n = c.bytes - i < 4093 ? c.bytes - i : 4093;
+        sesion.alimentar(c.datos + i, (int)n);
+    }
+    sesion.finalizar();
+    
+    Referencia r;
+    r.caracteres = sesion.getCarga().getLongitud();
+    r.mensaje = new char[r.caracteres > 0 ? r.caracteres : 1];
+    sesion.getCarga().copiarMensaje(r.mensaje, (int)r.caracteres);
+    r.tramas = sesion.getTramas();
+    r.malformadas = sesion.getMalformadas();
+    return r;
+}
+
+// ¿El archivo tiene exactamente el mensaje de referencia?
+static bool mismoContenido(const char* ruta, const Referencia& r) {
+    FILE* f = fopen(ruta, "rb");
+    if(!f) return false;
+    char* leido = new char[r.caracteres + 1];
+    size_t n = fread(leido, 1, (size_t)r.caracteres + 1, f);
+    fclose(f);
+    bool igual = n == (size_t)r.caracteres && memcmp(leido, r.mensaje, n) == 0;
+    delete[] leido;
+    return igual;
+}
+
+/**
+ * @struct FilaManifiesto
+ * @brief Columnas numéricas de una fila de manifiesto.tsv
+ */
+struct FilaManifiesto {
+    unsigned long tramas;
+    unsigned long malformadas;
+    long caracteres;
+    int trozos;
+    bool ok;
+};
+
+// Buscar la fila de la captura en el manifiesto
+static bool leerManifiesto(const char* dirSalida, const char* captura, FilaManifiesto& fila) {
+    char ruta[1024];
+    snprintf(ruta, sizeof(ruta), "%s/manifiesto.tsv", dirSalida);
+    FILE* f = fopen(ruta, "r");
+    if(!f) return false;
+    
+    char linea[4096];
+    bool encontrada = false;
+    size_t largo = strlen(captura);
+    while(!encontrada && fgets(linea, sizeof(linea), f)) {
+        if(strncmp(linea, captura, largo) != 0 || linea[largo] != '\t') continue;
+        size_t bytes;
+        char estado[16];
+        encontrada = sscanf(linea + largo, "\t%zu\t%lu\t%lu\t%ld\t%d\t%*f\t%15s", &bytes, &fila.tramas,
+                            &fila.malformadas, &fila.caracteres, &fila.trozos, estado) == 6;
+        fila.ok = encontrada && strcmp(estado, "OK") == 0;
+    }
+    fclose(f);
+    return encontrada;
+}
+
+// Decodificar el lote y comparar cada captura con su referencia
+static void probarConfiguracion(const char* base, const char* entrada, const Captura* capturas,
+                                const char* const* nombres, int hilos, int desplazamiento, bool estricto) {
+    char salida[512];
+    char almacen[512];
+    snprintf(salida, sizeof(salida), "%s/salida", base);
+    snprintf(almacen, sizeof(almacen), "%s/referencia.bin", base);
+    
+    ConfigLote cfg = { entrada, salida, hilos, desplazamiento, estricto, nullptr, 0 };
+    bool ok;
+    {
+        DecodificadorLote lote(cfg);
+        ok = lote.ejecutar();
+    }
+    
+    char caso[160];
+    snprintf(caso, sizeof(caso), "%d hilos, desplazamiento %d, %s", hilos, desplazamiento,
+             estricto ? "estricto" : "tolerante");
+    verificar(ok, caso, "el lote termina sin errores");
+    
+    for(int i = 0; i < 2; i++) {
+        Referencia r = referencia(capturas[i], almacen, desplazamiento, estricto);
+        unlink(almacen);
+        
+        char captura[1024];
+        char resultado[1024];
+        snprintf(captura, sizeof(captura), "%s/%s", entrada, nombres[i]);
+        snprintf(resultado, sizeof(resultado), "%s/%s.txt", salida, nombres[i]);
+        
+        char que[160];
+        snprintf(que, sizeof(que), "%s: resultado igual al de la sesión", nombres[i]);
+        verificar(mismoContenido(resultado, r), caso, que);
+        
+        FilaManifiesto fila;
+        snprintf(que, sizeof(que), "%s: fila del manifiesto", nombres[i]);
+        verificar(leerManifiesto(salida, captura, fila) && fila.ok, caso, que);
+        snprintf(que, sizeof(que), "%s: tramas, malformadas y caracteres de la sesión", nombres[i]);
+        verificar(fila.tramas == r.tramas && fila.malformadas == r.malformadas &&
+                  fila.caracteres == r.caracteres, caso, que);
+        snprintf(que, sizeof(que), "%s: cantidad de trozos", nombres[i]);
+        verificar(i == 0 ? fila.trozos == 5 : fila.trozos == 1, caso, que);
+        delete[] r.mensaje;
+    }
+    borrarDirectorio(salida);
+}
+
+int main() {
+    TramaBase::setDetalle(false);
+    
+    char base[] = "/tmp/prueba_lote.XXXXXX";
+    if(!mkdtemp(base)) {
+        std::cerr << "[ERROR] No se pudo crear el directorio temporal" << std::endl;
+        return 1;
+    }
+    char entrada[512];
+    snprintf(entrada, sizeof(entrada), "%s/entrada", base);
+    mkdir(entrada, 0755);
+    
+    const char* nombres[2] = { "grande.log", "chica.log" };
+    Captura capturas[2] = { generar(BYTES_GRANDE), generar(BYTES_CHICA) };
+    char ruta[1024];
+    for(int i = 0; i < 2; i++) {
+        snprintf(ruta, sizeof(ruta), "%s/%s", entrada, nombres[i]);
+        verificar(escribirCaptura(ruta, capturas[i]), nombres[i], "escribir la captura");
+    }
+    
+    probarConfiguracion(base, entrada, capturas, nombres, 4, 0, false);
+    probarConfiguracion(base, entrada, capturas, nombres, 3, 7, true);
+    probarConfiguracion(base, entrada, capturas, nombres, 1, -30, false);
+    
+    for(int i = 0; i < 2; i++) delete[] capturas[i].datos;
+    borrarDirectorio(entrada);
+    rmdir(base);
+    return terminarPruebas("lote");
+}
@@ -0,0 +1,143 @@
+// ============================================================================
+// prueba_memoria_compartida.cpp - Pruebas de Comportamiento del Anillo Compartido
+// ============================================================================
+// Publica caracteres y rotaciones con PublicadorMemoria y los lee con
+// SuscriptorMemoria: orden y contenido de cada registro, conexión desde
+// el inicio o sólo para lo nuevo, desborde de un lector atrasado,
+// escritor que termina, capacidades fuera de rango y un escritor y un
+// lector concurrentes (cada registro leído llega entero y en orden).
+// Termina con código distinto de cero si alguna verificación falla.
+//
+// Uso:
+//   prueba_memoria_compartida
+// ============================================================================
+
+#include "verificacion.h"
+#include "MemoriaCompartida.h"
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+static char nombre[64];
+
+// Registros, contenido y orden
+static void probarRegistros() {
+    PublicadorMemoria publicador(nombre, 8);
+    verificar(publicador.estaListo(), "crear el segmento");
+    SuscriptorMemoria nuevo(nombre, false);
+    verificar(nuevo.estaConectado() && nuevo.escritorActivo(), "conectar un suscriptor");
+    
+    RegistroDecodificado reg;
+    verificar(!nuevo.leer(reg), "sin registros publicados no hay nada que leer");
+    
+    publicador.alInsertar('H', 1);
+    publicador.publicarRotacion(-7, 2);
+    publicador.alInsertar('\xF1', 3);
+    verificar(publicador.getPublicados() == 3, "tres registros publicados");
+    
+    verificar(nuevo.leer(reg) && reg.numero == 0 && reg.tipo == 'L' && reg.dato == 'H' &&
+              reg.indiceTrama == 1, "primer registro: carácter H de la trama 1");
+    verificar(nuevo.leer(reg) && reg.numero == 1 && reg.tipo == 'M' && reg.rotacion == -7 &&
+              reg.indiceTrama == 2, "segundo registro: rotación negativa intacta");
+    verificar(nuevo.leer(reg) && reg.tipo == 'L' && reg.dato == '\xF1', "un byte alto llega igual");
+    verificar(reg.marcaTiempoNs > 0, "cada registro lleva su marca de tiempo");
+    verificar(!nuevo.leer(reg) && nuevo.getPerdidos() == 0, "leído todo, sin pérdidas");
+    
+    // Un suscriptor tardío sólo ve lo nuevo, salvo que pida el inicio
+    SuscriptorMemoria tarde(nombre, false);
+    SuscriptorMemoria inicio(nombre, true);
+    verificar(!tarde.leer(reg), "sin --desde-inicio no se ve lo ya publicado");
+    verificar(inicio.leer(reg) && reg.numero == 0, "con --desde-inicio se empieza por el registro 0");
+    publicador.alInsertar('Z', 4);
+    verificar(tarde.leer(reg) && reg.numero == 3 && reg.dato == 'Z', "el suscriptor tardío recibe lo nuevo");
+}
+
+// Lector atrasado y escritor que termina
+static void probarDesborde() {
+    SuscriptorMemoria* lento;
+    RegistroDecodificado reg;
+    {
+        // 5 ranuras se redondean a 8
+        PublicadorMemoria publicador(nombre, 5);
+        lento = new SuscriptorMemoria(nombre, false);
+        for(int i = 0; i < 20; i++) publicador.alInsertar((char)('a' + i), (unsigned long)i);
+        
+        SuscriptorMemoria inicio(nombre, true);
+        verificar(inicio.leer(reg) && reg.numero == 12, "desde el inicio arranca en el más antiguo válido");
+        
+        verificar(lento->leer(reg) && reg.numero == 12 && reg.dato == 'a' + 12,
+                  "el lector atrasado salta al más antiguo válido");
+        verificar(lento->getPerdidos() == 12, "los 12 sobrescritos cuentan como perdidos");
+    }
+    
+    // El publicador ya no existe: lo mapeado se puede terminar de leer
+    verificar(!lento->escritorActivo(), "el suscriptor ve que el escritor terminó");
+    int restantes = 0;
+    while(lento->leer(reg)) restantes++;
+    verificar(restantes == 7 && reg.dato == 'a' + 19, "después del cierre se leen los 7 restantes");
+    delete lento;
+    
+    SuscriptorMemoria borrado(nombre, false);
+    verificar(!borrado.estaConectado(), "el nombre se elimina al destruir el publicador");
+}
+
+// Capacidades en los bordes
+static void probarCapacidad() {
+    PublicadorMemoria excedido(nombre, PublicadorMemoria::MAX_CAPACIDAD + 1);
+    verificar(!excedido.estaListo(), "más de MAX_CAPACIDAD ranuras es un error");
+    
+    PublicadorMemoria enorme(nombre, ~0ull);
+    verificar(!enorme.estaListo(), "una capacidad cercana a 2^64 no cuelga el redondeo");
+    
+    PublicadorMemoria una(nombre, 1);
+    SuscriptorMemoria lector(nombre, false);
+    una.alInsertar('x', 1);
+    una.alInsertar('y', 2);
+    RegistroDecodificado reg;
+    verificar(una.estaListo() && lector.leer(reg) && reg.dato == 'y' && lector.getPerdidos() == 1,
+              "con una ranura sólo queda el último registro");
+}
+
+// Cuerpo del escritor concurrente: el dato es el número de registro
+static void escribir(PublicadorMemoria* publicador, int total) {
+    for(int i = 0; i < total; i++) {
+        publicador->alInsertar((char)(i & 0x7F), (unsigned long)i);
+    }
+}
+
+// Escritor y lector a la vez
+static void probarConcurrencia() {
+    const int total = 200000;
+    PublicadorMemoria publicador(nombre, 64);
+    SuscriptorMemoria lector(nombre, false);
+    std::thread escritor(escribir, &publicador, total);
+    
+    // Cada registro se lee o se cuenta como perdido: termina al cubrirlos todos
+    RegistroDecodificado reg;
+    unsigned long leidos = 0;
+    bool enteros = true;
+    bool enOrden = true;
+    long ultimo = -1;
+    while(leidos + lector.getPerdidos() < (unsigned long)total) {
+        if(!lector.leer(reg)) continue;
+        leidos++;
+        if(reg.indiceTrama != reg.numero || reg.dato != (char)(reg.numero & 0x7F)) enteros = false;
+        if((long)reg.numero <= ultimo) enOrden = false;
+        ultimo = (long)reg.numero;
+    }
+    escritor.join();
+    
+    verificar(enteros, "ningún registro llega mezclado con otro");
+    verificar(enOrden, "los números de registro sólo crecen");
+    verificar(!lector.leer(reg) && leidos + lector.getPerdidos() == (unsigned long)total,
+              "leídos + perdidos = publicados");
+}
+
+int main() {
+    snprintf(nombre, sizeof(nombre), "/prt7_prueba_%d", (int)getpid());
+    probarRegistros();
+    probarDesborde();
+    probarCapacidad();
+    probarConcurrencia();
+    return terminarPruebas("memoria_compartida");
+}
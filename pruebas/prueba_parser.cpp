@@ -0,0 +1,169 @@
+// ============================================================================
+// prueba_parser.cpp - Pruebas de Comportamiento de parsearTrama
+// ============================================================================
+// Recorre los formatos del protocolo en modo tolerante y estricto: tramas
+// L y M con cargas de más o de menos, tramas B con largo exacto, corto y
+// sobrante, y el prefijo de secuencia "S:". Termina con código distinto
+// de cero si alguna verificación falla.
+//
+// Uso:
+//   prueba_parser
+// ============================================================================
+
+#include "verificacion.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+
+// La línea se rechaza en el modo dado
+static void rechazada(const char* linea, bool estricto) {
+    TramaBase* t = parsearCopia(linea, estricto);
+    verificar(t == nullptr, linea, estricto ? "debía rechazarse en modo estricto"
+                                            : "debía rechazarse en modo tolerante");
+    delete t;
+}
+
+// La línea es una trama L con ese carácter
+static void esCarga(const char* linea, bool estricto, char esperado) {
+    TramaBase* t = parsearCopia(linea, estricto);
+    verificar(t && t->getTipo() == 'L', linea, "debía ser una trama L");
+    if(t && t->getTipo() == 'L') {
+        verificar(static_cast<TramaLoad*>(t)->getCaracter() == esperado, linea, "carácter distinto");
+    }
+    delete t;
+}
+
+// La línea es una trama M con esa rotación
+static void esMapa(const char* linea, bool estricto, int esperada) {
+    TramaBase* t = parsearCopia(linea, estricto);
+    verificar(t && t->getTipo() == 'M', linea, "debía ser una trama M");
+    if(t && t->getTipo() == 'M') {
+        verificar(static_cast<TramaMap*>(t)->getRotacion() == esperada, linea, "rotación distinta");
+    }
+    delete t;
+}
+
+// La línea es una trama B con esa carga
+static void esMasiva(const char* linea, bool estricto, const char* esperada) {
+    TramaBase* t = parsearCopia(linea, estricto);
+    verificar(t && t->getTipo() == 'B', linea, "debía ser una trama B");
+    if(t && t->getTipo() == 'B') {
+        TramaCargaMasiva* b = static_cast<TramaCargaMasiva*>(t);
+        int n = (int)strlen(esperada);
+        verificar(b->getLargo() == n, linea, "largo distinto");
+        verificar(b->getLargo() == n && memcmp(b->getCarga(), esperada, n) == 0, linea, "carga distinta");
+    }
+    delete t;
+}
+
+// Tramas L y M en los dos modos
+static void probarLoadMap() {
+    for(int m = 0; m < 2; m++) {
+        bool estricto = m == 1;
+        esCarga("L,A", estricto, 'A');
+        esCarga("L, ", estricto, ' ');
+        esMapa("M,5", estricto, 5);
+        esMapa("M,-3", estricto, -3);
+        rechazada("", estricto);
+        rechazada("L", estricto);
+        rechazada("LA", estricto);
+        rechazada("X,1", estricto);
+        rechazada("l,A", estricto);
+    }
+    
+    // El modo tolerante mira sólo el tipo y la coma
+    esCarga("L,", false, '\0');
+    esCarga("L,AB", false, 'A');
+    esMapa("M,x", false, 0);
+    esMapa("M,5z", false, 5);
+    
+    rechazada("L,", true);
+    rechazada("L,AB", true);
+    rechazada("M,x", true);
+    rechazada("M,", true);
+    rechazada("M,5z", true);
+    rechazada("M,2000000", true);
+    rechazada("M,99999999999999999999", true);
+}
+
+// Tramas B: largo obligatorio, carga exacta sólo en modo estricto
+static void probarMasiva() {
+    char larga[TramaCargaMasiva::MAX_CARGA + 16];
+    char esperada[TramaCargaMasiva::MAX_CARGA + 1];
+    
+    for(int m = 0; m < 2; m++) {
+        bool estricto = m == 1;
+        esMasiva("B,4,HOLA", estricto, "HOLA");
+        esMasiva("B,0,", estricto, "");
+        esMasiva("B,3,A,B", estricto, "A,B");
+        rechazada("B,", estricto);
+        rechazada("B,4", estricto);
+        rechazada("B,,HOLA", estricto);
+        rechazada("B,-1,A", estricto);
+        rechazada("B,x,HOLA", estricto);
+        rechazada("B,99999999999999999999,A", estricto);
+        
+        // Justo en el máximo y uno más
+        int n = TramaCargaMasiva::MAX_CARGA;
+        int p = snprintf(larga, sizeof(larga), "B,%d,", n);
+        memset(larga + p, 'Z', n);
+        larga[p + n] = '\0';
+        memset(esperada, 'Z', n);
+        esperada[n] = '\0';
+        esMasiva(larga, estricto, esperada);
+        
+        p = snprintf(larga, sizeof(larga), "B,%d,", n + 1);
+        memset(larga + p, 'Z', n + 1);
+        larga[p + n + 1] = '\0';
+        rechazada(larga, estricto);
+    }
+    
+    // Carga corta o sobrante: tolerante toma lo que hay hasta N
+    esMasiva("B,4,HO", false, "HO");
+    esMasiva("B,2,HOLA", false, "HO");
+    rechazada("B,4,HO", true);
+    rechazada("B,2,HOLA", true);
+}
+
+// Prefijo de secuencia "S:" en los tres tipos
+static void probarSecuencia() {
+    const char* lineas[3] = { "17:L,A", "18:M,-2", "19:B,2,OK" };
+    const char tipos[3] = { 'L', 'M', 'B' };
+    for(int m = 0; m < 2; m++) {
+        bool estricto = m == 1;
+        for(int i = 0; i < 3; i++) {
+            TramaBase* t = parsearCopia(lineas[i], estricto);
+            verificar(t && t->getTipo() == tipos[i], lineas[i], "tipo distinto");
+            verificar(t && t->tieneSecuencia(), lineas[i], "debía traer secuencia");
+            verificar(t && t->getSecuencia() == (unsigned long)(17 + i), lineas[i], "secuencia distinta");
+            delete t;
+        }
+        
+        TramaBase* t = parsearCopia("0:L,A", estricto);
+        verificar(t && t->tieneSecuencia() && t->getSecuencia() == 0, "0:L,A", "secuencia 0");
+        delete t;
+        
+        t = parsearCopia("L,A", estricto);
+        verificar(t && !t->tieneSecuencia(), "L,A", "no debía traer secuencia");
+        delete t;
+        
+        rechazada("17L,A", estricto);
+        rechazada("17:", estricto);
+        rechazada("17:X,1", estricto);
+        rechazada("17::L,A", estricto);
+    }
+    esCarga("5:L,", false, '\0');
+    rechazada("5:L,", true);
+    esMapa("6:M,4", true, 4);
+    esMasiva("7:B,3,ABC", true, "ABC");
+}
+
+int main() {
+    TramaBase::setDetalle(false);
+    
+    probarLoadMap();
+    probarMasiva();
+    probarSecuencia();
+    
+    return terminarPruebas("parser");
+}
@@ -0,0 +1,173 @@
+// ============================================================================
+// prueba_pool_nodos.cpp - Pruebas de Comportamiento de PoolNodos
+// ============================================================================
+// Reserva bloques de tipos chicos y grandes y revisa que queden alineados
+// sin cruzar líneas de caché, contiguos dentro de una losa y sin pisarse;
+// que los devueltos se reciclen, que las losas crezcan hasta su tope, que
+// prereservar() deje bloques contiguos sin pedir losas nuevas, que
+// liberarTodo() ponga los contadores en cero y que delHilo() dé una
+// instancia distinta por hilo. Termina con código distinto de cero si
+// alguna verificación falla.
+//
+// Uso:
+//   prueba_pool_nodos
+// ============================================================================
+
+#include "verificacion.h"
+#include "PoolNodos.h"
+#include <new>
+#include <thread>
+
+/**
+ * @struct Chico
+ * @brief Tipo de 24 bytes (bloque de 32, dos por línea de caché)
+ */
+struct Chico {
+    unsigned long a, b, c;
+};
+
+/**
+ * @struct Grande
+ * @brief Tipo de 100 bytes (bloque de 128, dos líneas de caché)
+ */
+struct Grande {
+    char datos[100];
+};
+
+static const int CANTIDAD = 1000;
+
+// Distancia en bytes entre dos bloques
+static long distancia(void* a, void* b) {
+    return (long)((char*)b - (char*)a);
+}
+
+// Alineación, contigüidad y bloques que no se pisan
+static void probarBloques() {
+    PoolNodos<Chico> chicos;
+    Chico* c[CANTIDAD];
+    bool contiguos = true;
+    bool enUnaLinea = true;
+    for(int i = 0; i < CANTIDAD; i++) {
+        c[i] = new (chicos.reservar()) Chico();
+        c[i]->a = c[i]->b = c[i]->c = (unsigned long)i;
+        if(i > 0 && distancia(c[i - 1], c[i]) != 32) contiguos = false;
+        if((size_t)c[i] % 64 + 32 > 64) enUnaLinea = false;
+    }
+    verificar((size_t)c[0] % 64 == 0, "el primer bloque empieza en una línea de caché");
+    verificar(contiguos, "bloques chicos consecutivos a 32 bytes dentro de una losa");
+    verificar(enUnaLinea, "ningún bloque chico cruza una línea de caché");
+    
+    bool intactos = true;
+    for(int i = 0; i < CANTIDAD; i++) {
+        if(c[i]->a != (unsigned long)i || c[i]->c != (unsigned long)i) intactos = false;
+    }
+    verificar(intactos, "escribir un bloque no pisa a los vecinos");
+    verificar(chicos.getEstadisticas().losas == 1, "mil bloques chicos caben en una losa de 64 KB");
+    
+    PoolNodos<Grande> grandes;
+    void* g0 = grandes.reservar();
+    void* g1 = grandes.reservar();
+    verificar((size_t)g0 % 64 == 0 && distancia(g0, g1) == 128,
+              "un tipo de 100 bytes ocupa dos líneas enteras");
+}
+
+// Reciclado de bloques y contadores
+static void probarReciclado() {
+    PoolNodos<Chico> pool;
+    void* a = pool.reservar();
+    void* b = pool.reservar();
+    void* c = pool.reservar();
+    verificar(pool.getEstadisticas().vivos == 3 && pool.getEstadisticas().maxVivos == 3,
+              "tres bloques vivos");
+    
+    pool.liberar(b);
+    pool.liberar(a);
+    verificar(pool.getEstadisticas().vivos == 1, "liberar descuenta los vivos");
+    verificar(pool.reservar() == a && pool.reservar() == b, "los devueltos se reusan en orden inverso");
+    verificar(distancia(c, pool.reservar()) == 32, "vacía la lista libre, sigue la losa");
+    verificar(pool.getEstadisticas().maxVivos == 4, "máximo histórico de vivos");
+    
+    pool.liberar(nullptr);
+    verificar(pool.getEstadisticas().vivos == 4, "liberar(nullptr) no hace nada");
+    
+    pool.liberarTodo();
+    const EstadisticasPool& s = pool.getEstadisticas();
+    verificar(s.vivos == 0 && s.losas == 0 && s.bytesReservados == 0, "liberarTodo pone los contadores en cero");
+    verificar((size_t)pool.reservar() % 64 == 0, "después de liberarTodo se puede seguir reservando");
+}
+
+// Losas que duplican su tamaño hasta el tope
+static void probarCrecimiento() {
+    PoolNodos<Chico> pool(4);
+    for(int i = 0; i < 4; i++) pool.reservar();
+    verificar(pool.getEstadisticas().losas == 1, "la primera losa tiene 4 bloques");
+    verificar(pool.getEstadisticas().bytesReservados == 64 + 4 * 32 + 64,
+              "bytes de la primera losa (cabecera, bloques y margen de alineación)");
+    
+    pool.reservar();
+    verificar(pool.getEstadisticas().losas == 2, "el quinto bloque abre otra losa");
+    for(int i = 0; i < 7; i++) pool.reservar();
+    verificar(pool.getEstadisticas().losas == 2, "la segunda losa tiene 8 bloques");
+    pool.reservar();
+    verificar(pool.getEstadisticas().losas == 3, "la tercera losa empieza en el bloque 13");
+    
+    // Tope: 64 KB / 32 bytes = 2048 bloques por losa
+    PoolNodos<Chico> tope(1024);
+    for(int i = 0; i < 1024 + 2048 + 2048; i++) tope.reservar();
+    verificar(tope.getEstadisticas().losas == 3, "las losas no pasan de 64 KB");
+    tope.reservar();
+    verificar(tope.getEstadisticas().losas == 4, "pasado el tope se abre otra losa del mismo tamaño");
+}
+
+// prereservar deja bloques contiguos listos
+static void probarPrereserva() {
+    PoolNodos<Chico> pool(8);
+    pool.prereservar(20);
+    const EstadisticasPool& s = pool.getEstadisticas();
+    verificar(s.losas == 2 && s.vivos == 0, "prereservar 20 abre las losas de 8 y 16 sin bloques vivos");
+    
+    void* anterior = pool.reservar();
+    bool contiguos = true;
+    for(int i = 1; i < 8; i++) {
+        void* p = pool.reservar();
+        if(distancia(anterior, p) != 32) contiguos = false;
+        anterior = p;
+    }
+    verificar(contiguos, "los prereservados salen en orden de dirección");
+    for(int i = 8; i < 20; i++) pool.reservar();
+    verificar(s.losas == 2 && s.vivos == 20, "los 20 prereservados no piden losas");
+    pool.reservar();
+    verificar(s.losas == 2, "la losa de 16 todavía tiene lugar");
+}
+
+// Cuerpo del segundo hilo: usa su pool y anota lo que vio
+static void usarPoolDelHilo(PoolNodos<Chico>** pool, size_t* vivos) {
+    PoolNodos<Chico>& propio = PoolNodos<Chico>::delHilo();
+    *pool = &propio;
+    void* p = propio.reservar();
+    *vivos = propio.getEstadisticas().vivos;
+    propio.liberar(p);
+}
+
+// Un pool por hilo
+static void probarPorHilo() {
+    PoolNodos<Chico>* principal = &PoolNodos<Chico>::delHilo();
+    verificar(principal == &PoolNodos<Chico>::delHilo(), "el mismo hilo recibe siempre su pool");
+    
+    PoolNodos<Chico>* otro = nullptr;
+    size_t vivosOtro = 0;
+    std::thread hilo(usarPoolDelHilo, &otro, &vivosOtro);
+    hilo.join();
+    verificar(otro && otro != principal, "otro hilo recibe otra instancia");
+    verificar(vivosOtro == 1 && principal->getEstadisticas().vivos == 0,
+              "los contadores de cada hilo son independientes");
+}
+
+int main() {
+    probarBloques();
+    probarReciclado();
+    probarCrecimiento();
+    probarPrereserva();
+    probarPorHilo();
+    return terminarPruebas("pool_nodos");
+}
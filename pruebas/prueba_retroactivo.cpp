@@ -0,0 +1,211 @@
+// ============================================================================
+// prueba_retroactivo.cpp - Pruebas de Comportamiento de DecodificadorRetroactivo
+// ============================================================================
+// Aplica un flujo secuenciado con MAP que llegan tarde, cambian de valor o
+// se quitan, cargas tardías y una secuencia fuera de alcance. Después de
+// cada paso el mensaje, cada decodificadoEn(i) y el rotor vivo deben
+// coincidir con decodificar en orden las tramas vigentes con procesar(),
+// sea cual sea el mapeo del rotor. Verifica también los contadores de
+// correcciones, caracteres re-decodificados y descartes, y que la cola
+// de EstadoPublicado (lo que ve --consultas) siga al mensaje corregido.
+// Termina con código distinto de cero si alguna verificación falla.
+//
+// Uso:
+//   prueba_retroactivo
+// ============================================================================
+
+#include "verificacion.h"
+#include "DecodificadorRetroactivo.h"
+#include "EstadoPublicado.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+static const int POSICIONES = 16;   // Posiciones 0..15 del flujo de prueba
+static const int LARGO_MENSAJE = 64;
+
+/**
+ * @struct Escenario
+ * @brief Decodificador bajo prueba y las tramas vigentes por posición
+ */
+struct Escenario {
+    ListaDeCarga carga;
+    RotorDeMapeo rotor;
+    EstadoPublicado estado;     ///< Observador de la lista, como con --consultas
+    DecodificadorRetroactivo* decodificador;
+    const char* vigente[POSICIONES];    ///< Cuerpo de la trama en cada posición (sin "S:")
+};
+
+// Aplicar "S:cuerpo" y anotar el cuerpo como vigente en S
+static void aplicar(Escenario& e, unsigned long pos, const char* cuerpo) {
+    char linea[64];
+    snprintf(linea, sizeof(linea), "%lu:%s", pos, cuerpo);
+    TramaBase* t = parsearCopia(linea, true);
+    verificar(t != nullptr, linea);
+    if(!t) return;
+    e.decodificador->aplicar(t);
+    delete t;
+    if(pos < (unsigned long)POSICIONES) e.vigente[pos] = cuerpo;
+}
+
+// Decodificar en orden las tramas vigentes y comparar todo
+static void comparar(Escenario& e, const char* paso) {
+    ListaDeCarga referencia;
+    RotorDeMapeo rotor;
+    for(int p = 0; p < POSICIONES; p++) {
+        if(!e.vigente[p]) continue;
+        TramaBase* t = parsearCopia(e.vigente[p], true);
+        t->procesar(&referencia, &rotor);
+        delete t;
+    }
+    
+    char esperado[LARGO_MENSAJE];
+    char obtenido[LARGO_MENSAJE];
+    int n = referencia.copiarMensaje(esperado, LARGO_MENSAJE);
+    int m = e.carga.copiarMensaje(obtenido, LARGO_MENSAJE);
+    
+    char que[160];
+    snprintf(que, sizeof(que), "%s: mensaje igual al decodificado en orden", paso);
+    verificar(n == m && memcmp(esperado, obtenido, n) == 0, que);
+    
+    bool iguales = true;
+    for(int i = 0; i < n; i++) {
+        if(e.decodificador->decodificadoEn(i) != esperado[i]) iguales = false;
+    }
+    snprintf(que, sizeof(que), "%s: decodificadoEn coincide en cada carga", paso);
+    verificar(iguales, que);
+    
+    snprintf(que, sizeof(que), "%s: el rotor vivo tiene la rotación corregida", paso);
+    verificar(e.rotor.getDesplazamiento() == rotor.getDesplazamiento(), que);
+    
+    Instantanea inst;
+    e.estado.leer(inst, LARGO_MENSAJE);
+    snprintf(que, sizeof(que), "%s: la cola publicada muestra el mensaje corregido", paso);
+    verificar(inst.largoCola == m && memcmp(inst.cola, obtenido, m) == 0, que);
+}
+
+// Una reescritura más larga que la cola sólo corrige lo que se conserva
+static void probarColaParcial() {
+    EstadoPublicado estado;
+    const int total = Instantanea::MAX_COLA + 100;
+    for(int i = 0; i < total; i++) estado.alInsertar('a', 1);
+    
+    char nuevos[Instantanea::MAX_COLA + 50];
+    memset(nuevos, 'z', sizeof(nuevos));
+    estado.alReescribir(50, nuevos, (int)sizeof(nuevos));
+    
+    Instantanea inst;
+    estado.leer(inst);
+    bool corregida = inst.largoCola == Instantanea::MAX_COLA;
+    for(int i = 0; i < inst.largoCola; i++) {
+        if(inst.cola[i] != 'z') corregida = false;
+    }
+    verificar(corregida, "la parte de la reescritura que sigue en la cola se corrige");
+    verificar(inst.caracteres == (unsigned long)total, "reescribir no cuenta caracteres nuevos");
+    
+    nuevos[0] = 'y';
+    estado.alReescribir(total - 1, nuevos, 1);
+    estado.leer(inst);
+    verificar(inst.cola[inst.largoCola - 1] == 'y' && inst.cola[inst.largoCola - 2] == 'z',
+              "reescribir el último carácter sólo toca ese");
+}
+
+// Contadores acumulados del decodificador
+static void contadores(Escenario& e, unsigned long correcciones, unsigned long redecodificados,
+                       unsigned long descartadas, const char* paso) {
+    char que[160];
+    snprintf(que, sizeof(que), "%s: correcciones = %lu", paso, correcciones);
+    verificar(e.decodificador->getCorrecciones() == correcciones, que);
+    snprintf(que, sizeof(que), "%s: re-decodificados = %lu", paso, redecodificados);
+    verificar(e.decodificador->getRedecodificados() == redecodificados, que);
+    snprintf(que, sizeof(que), "%s: descartadas = %lu", paso, descartadas);
+    verificar(e.decodificador->getDescartadas() == descartadas, que);
+}
+
+int main() {
+    TramaBase::setDetalle(false);
+    
+    Escenario e;
+    for(int p = 0; p < POSICIONES; p++) e.vigente[p] = nullptr;
+    e.carga.agregarObservador(&e.estado);
+    e.decodificador = new DecodificadorRetroactivo(&e.carga, &e.rotor);
+    
+    // Flujo sin los MAP de las posiciones 2 y 5
+    // Cargas: H(1) O(3) LAM(4) U(6) N(7) D(8) O(10) -> índices 0..8
+    aplicar(e, 0, "M,0");
+    aplicar(e, 1, "L,H");
+    aplicar(e, 3, "L,O");
+    aplicar(e, 4, "B,3,LAM");
+    aplicar(e, 6, "L,U");
+    aplicar(e, 7, "L,N");
+    aplicar(e, 8, "L,D");
+    aplicar(e, 9, "M,2");
+    aplicar(e, 10, "L,O");
+    comparar(e, "en orden");
+    contadores(e, 0, 0, 0, "en orden");
+    
+    // MAP insertado tarde: re-decodifica desde la carga 1 (8 caracteres)
+    aplicar(e, 2, "M,3");
+    comparar(e, "MAP 2 tardío");
+    contadores(e, 1, 8, 0, "MAP 2 tardío");
+    
+    // Otro MAP tardío: sólo desde la carga 5 (U N D O)
+    aplicar(e, 5, "M,-7");
+    comparar(e, "MAP 5 tardío");
+    contadores(e, 2, 12, 0, "MAP 5 tardío");
+    
+    // MAP existente que cambia de valor: sólo la última O
+    aplicar(e, 9, "M,5");
+    comparar(e, "MAP 9 cambiado");
+    contadores(e, 3, 13, 0, "MAP 9 cambiado");
+    
+    // MAP quitado
+    verificar(e.decodificador->eliminarMapa(2) == 8, "quitar el MAP 2 re-decodifica 8 caracteres");
+    e.vigente[2] = nullptr;
+    comparar(e, "MAP 2 quitado");
+    contadores(e, 4, 21, 0, "MAP 2 quitado");
+    
+    // Quitar un MAP que no existe no cambia nada
+    verificar(e.decodificador->eliminarMapa(2) == 0, "quitar dos veces no re-decodifica");
+    contadores(e, 4, 21, 0, "MAP 2 quitado dos veces");
+    
+    // Carga tardía: no se puede insertar en el medio
+    aplicar(e, 3, "L,X");
+    e.vigente[3] = "L,O";
+    comparar(e, "carga tardía");
+    contadores(e, 4, 21, 1, "carga tardía");
+    
+    // Secuencia corrupta muy por delante: se descarta sin crecer
+    aplicar(e, 4000000000UL, "M,1");
+    verificar(e.decodificador->fijarMapa(4000000000UL, 1) == 0, "fijarMapa fuera de alcance no hace nada");
+    comparar(e, "fuera de alcance");
+    contadores(e, 4, 21, 2, "fuera de alcance");
+    
+    // MAP posterior a la última carga: queda pendiente, no es corrección
+    aplicar(e, 11, "M,4");
+    aplicar(e, 12, "L,Z");
+    comparar(e, "MAP pendiente");
+    contadores(e, 4, 21, 2, "MAP pendiente");
+    
+    // Trama sin secuencia: toma la posición siguiente a la última (13)
+    TramaBase* t = parsearCopia("L,Q", true);
+    e.decodificador->aplicar(t);
+    delete t;
+    e.vigente[13] = "L,Q";
+    comparar(e, "sin secuencia");
+    
+    // El MAP 2 vuelve: O(3) en adelante (10 caracteres)
+    aplicar(e, 2, "M,3");
+    comparar(e, "MAP 2 repuesto");
+    contadores(e, 5, 31, 2, "MAP 2 repuesto");
+    
+    // Corrección anterior a la primera carga: re-decodifica las 11, con
+    // MAP intermedios que se siguen sumando en el sufijo
+    aplicar(e, 0, "M,11");
+    comparar(e, "MAP 0 cambiado");
+    contadores(e, 6, 42, 2, "MAP 0 cambiado");
+    
+    delete e.decodificador;
+    
+    probarColaParcial();
+    return terminarPruebas("retroactivo");
+}
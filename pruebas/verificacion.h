@@ -0,0 +1,106 @@
+// ============================================================================
+// verificacion.h - Contadores y Reporte Comunes de las Pruebas
+// ============================================================================
+// Cada archivo de pruebas/ es un programa propio que enlaza las fuentes
+// del decodificador salvo main.cpp. Cuenta sus verificaciones, informa
+// las que fallan por stderr y termina con código distinto de cero si
+// falló alguna. También reúne las ayudas que usan varias pruebas
+// (parsear una línea constante, borrar el directorio temporal).
+// ============================================================================
+
+#ifndef VERIFICACION_H
+#define VERIFICACION_H
+
+#include "ParserTramas.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+
+/**
+ * @struct ResultadoPruebas
+ * @brief Verificaciones hechas y fallidas en el programa
+ */
+struct ResultadoPruebas {
+    int verificaciones;     ///< Verificaciones evaluadas
+    int fallas;             ///< Verificaciones que no se cumplieron
+};
+
+/**
+ * @brief Contadores del programa de prueba
+ */
+inline ResultadoPruebas& resultadoPruebas() {
+    static ResultadoPruebas r = { 0, 0 };
+    return r;
+}
+
+/**
+ * @brief Cuenta una verificación y la informa si falla
+ * @param condicion Lo que debe cumplirse
+ * @param que Descripción de lo verificado
+ */
+inline void verificar(bool condicion, const char* que) {
+    ResultadoPruebas& r = resultadoPruebas();
+    r.verificaciones++;
+    if(condicion) return;
+    r.fallas++;
+    std::cerr << "[FALLA] " << que << std::endl;
+}
+
+/**
+ * @brief Igual que verificar(), citando la entrada probada
+ * @param condicion Lo que debe cumplirse
+ * @param entrada Entrada que se estaba probando (ej: una línea del protocolo)
+ * @param que Descripción de lo verificado
+ */
+inline void verificar(bool condicion, const char* entrada, const char* que) {
+    ResultadoPruebas& r = resultadoPruebas();
+    r.verificaciones++;
+    if(condicion) return;
+    r.fallas++;
+    std::cerr << "[FALLA] \"" << entrada << "\": " << que << std::endl;
+}
+
+/**
+ * @brief Imprime el resumen del programa
+ * @param nombre Módulo probado
+ * @return Código de salida: 0 si no falló nada, 1 si no
+ */
+inline int terminarPruebas(const char* nombre) {
+    const ResultadoPruebas& r = resultadoPruebas();
+    std::cout << "[PRUEBA] " << nombre << ": " << r.verificaciones - r.fallas << "/"
+              << r.verificaciones << " verificaciones correctas" << std::endl;
+    return r.fallas == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Parsea una copia de la línea (parsearTrama recibe char*)
+ * @param linea Línea del protocolo
+ * @param estricto Modo del parser
+ */
+inline TramaBase* parsearCopia(const char* linea, bool estricto) {
+    char copia[LARGO_MAX_LINEA];
+    strncpy(copia, linea, sizeof(copia) - 1);
+    copia[sizeof(copia) - 1] = '\0';
+    return parsearTrama(copia, estricto);
+}
+
+/**
+ * @brief Borra un directorio temporal de la prueba y los archivos que tiene
+ * @param dir Directorio (sin subdirectorios)
+ */
+inline void borrarDirectorio(const char* dir) {
+    DIR* d = opendir(dir);
+    if(!d) return;
+    char ruta[1024];
+    for(struct dirent* e = readdir(d); e; e = readdir(d)) {
+        if(strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        snprintf(ruta, sizeof(ruta), "%s/%s", dir, e->d_name);
+        unlink(ruta);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+#endif // VERIFICACION_H
@@ -0,0 +1,138 @@
+// ============================================================================
+// RecuperadorDesplazamiento.cpp - Implementación de la Recuperación
+// ============================================================================
+
+#include "RecuperadorDesplazamiento.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaCargaMasiva.h"
+#include <cmath>
+#include <cstring>
+
+/// Frecuencia de cada letra A-Z en español, por cada 10000 letras
+static const int FRECUENCIA_ES[26] = {
+    1253, 142, 468, 586, 1368, 69, 101, 70, 625, 44, 2, 497, 315,
+    671, 868, 251, 88, 687, 798, 463, 393, 90, 1, 22, 90, 52
+};
+
+/// Frecuencia de cada letra A-Z en inglés, por cada 10000 letras
+static const int FRECUENCIA_EN[26] = {
+    817, 149, 278, 425, 1270, 223, 202, 609, 697, 15, 77, 403, 241,
+    675, 751, 193, 10, 599, 633, 906, 276, 98, 236, 15, 197, 7
+};
+
+/// Bigramas más frecuentes de ambos idiomas
+static const char* const BIGRAMAS_COMUNES[] = {
+    // Español
+    "DE", "ES", "EN", "EL", "LA", "OS", "AR", "RE", "ER", "AS", "ON", "UE",
+    "CO", "OR", "AD", "ST", "TA", "AN", "RA", "QU", "NT", "CI", "IO", "DO",
+    // Inglés
+    "TH", "HE", "IN", "AT", "ND", "TI", "TE", "OF", "ED", "IS", "IT", "AL",
+    "TO", "NG", "HA", "OU", "EA", "SE", "ME", "VE", "LE", "HI", "RI", "RO"
+};
+
+static const int BONO_BIGRAMA = 15;     ///< Puntos extra por un bigrama común
+
+// Constructor
+RecuperadorDesplazamiento::RecuperadorDesplazamiento(RotorDeMapeo* rotor, int ventanaTramas)
+    : tabla(rotor), candidatos(tabla.getTamanio()), rotacion(0), numRetenidas(0),
+      ventana(ventanaTramas > 0 ? ventanaTramas : 1) {
+    puntajes = new long long[candidatos];
+    previo = new unsigned char[candidatos];
+    for(int k = 0; k < candidatos; k++) {
+        puntajes[k] = 0;
+        previo[k] = OTRO;
+    }
+    retenidas = new TramaBase*[ventana];
+    construirModelo();
+    
+    distinguible = false;
+    for(int k = 1; k < candidatos && !distinguible; k++) {
+        distinguible = memcmp(tabla.tabla(k), tabla.tabla(0), 256) != 0;
+    }
+}
+
+// Destructor
+RecuperadorDesplazamiento::~RecuperadorDesplazamiento() {
+    for(int i = 0; i < numRetenidas; i++) delete retenidas[i];
+    delete[] retenidas;
+    delete[] puntajes;
+    delete[] previo;
+}
+
+// Modelo: log-frecuencia de la letra más un bono si el par es común
+void RecuperadorDesplazamiento::construirModelo() {
+    for(int c = 0; c < 256; c++) {
+        clase[c] = (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A') : (unsigned char)OTRO;
+    }
+    
+    short letra[OTRO + 1];
+    for(int l = 0; l < 26; l++) {
+        // Se toma el idioma en que la letra es más frecuente: una Z no debe
+        // hundir un texto español ni una W uno inglés
+        int f = FRECUENCIA_ES[l] > FRECUENCIA_EN[l] ? FRECUENCIA_ES[l] : FRECUENCIA_EN[l];
+        letra[l] = (short)lround(10.0 * log((f + 1) / 10000.0));
+    }
+    letra[OTRO] = 0;    // Espacios y signos no dependen de la hipótesis
+    
+    for(int a = 0; a <= OTRO; a++) {
+        for(int b = 0; b <= OTRO; b++) puntajeBigrama[a][b] = letra[b];
+    }
+    for(size_t i = 0; i < sizeof(BIGRAMAS_COMUNES) / sizeof(BIGRAMAS_COMUNES[0]); i++) {
+        const char* par = BIGRAMAS_COMUNES[i];
+        puntajeBigrama[par[0] - 'A'][par[1] - 'A'] += BONO_BIGRAMA;
+    }
+}
+
+// Un carácter bajo todas las hipótesis
+void RecuperadorDesplazamiento::puntuar(unsigned char c) {
+    // Carril k: rotor rotado k + rotacion; se recorre sin módulo por carril
+    int d = tabla.normalizar(rotacion);
+    for(int k = 0; k < candidatos; k++) {
+        unsigned char actual = clase[(unsigned char)tabla.tabla(d)[c]];
+        puntajes[k] += puntajeBigrama[previo[k]][actual];
+        previo[k] = actual;
+        if(++d == candidatos) d = 0;
+    }
+}
+
+// Puntuar bajo todas las hipótesis y retener
+bool RecuperadorDesplazamiento::retener(TramaBase* trama) {
+    if(trama->getTipo() == 'M') {
+        rotacion += static_cast<TramaMap*>(trama)->getRotacion();
+    } else if(trama->getTipo() == 'L') {
+        puntuar((unsigned char)static_cast<TramaLoad*>(trama)->getCaracter());
+    } else if(trama->getTipo() == 'B') {
+        TramaCargaMasiva* masiva = static_cast<TramaCargaMasiva*>(trama);
+        for(int i = 0; i < masiva->getLargo(); i++) puntuar((unsigned char)masiva->getCarga()[i]);
+    }
+    
+    if(numRetenidas < ventana) retenidas[numRetenidas++] = trama;
+    return numRetenidas >= ventana;
+}
+
+// Mejor hipótesis
+int RecuperadorDesplazamiento::getMejor() const {
+    int mejor = 0;
+    for(int k = 1; k < candidatos; k++) {
+        if(puntajes[k] > puntajes[mejor]) mejor = k;
+    }
+    return mejor;
+}
+
+// Segunda mejor hipótesis
+int RecuperadorDesplazamiento::getSegundo() const {
+    int mejor = getMejor();
+    int segundo = mejor == 0 ? 1 : 0;
+    for(int k = 0; k < candidatos; k++) {
+        if(k != mejor && puntajes[k] > puntajes[segundo]) segundo = k;
+    }
+    return segundo;
+}
+
+// Entregar una trama retenida
+TramaBase* RecuperadorDesplazamiento::tomarRetenida(int i) {
+    TramaBase* t = retenidas[i];
+    retenidas[i] = nullptr;
+    return t;
+}
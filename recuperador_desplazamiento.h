@@ -0,0 +1,120 @@
+// ============================================================================
+// RecuperadorDesplazamiento.h - Recuperación del Desplazamiento Inicial
+// ============================================================================
+
+#ifndef RECUPERADOR_DESPLAZAMIENTO_H
+#define RECUPERADOR_DESPLAZAMIENTO_H
+
+#include "TablaMapeo.h"
+#include "TramaBase.h"
+
+/**
+ * @class RecuperadorDesplazamiento
+ * @brief Elige el desplazamiento inicial del rotor cuando se engancha un
+ *        enlace a mitad del flujo
+ * 
+ * Si el decodificador arranca después que el emisor, la cabeza de su
+ * RotorDeMapeo no coincide con la del emisor y todo sale basura. El estado
+ * desconocido es uno de getTamanio() desplazamientos, así que se
+ * decodifican todos a la vez: por cada carácter cargado (L o B), las 26
+ * hipótesis avanzan juntas en arreglos paralelos (un carril por
+ * desplazamiento) usando TablaMapeo, y cada una acumula un puntaje de un
+ * modelo compacto de letras y bigramas del español y el inglés.
+ * 
+ * Las tramas se retienen hasta completar la ventana; entonces se elige el
+ * mejor puntaje y quien lo usa rota el rotor y reprocesa las retenidas
+ * con el camino normal. A partir de ahí no queda ningún costo extra.
+ */
+class RecuperadorDesplazamiento {
+private:
+    static const int OTRO = 26;     ///< Clase de los caracteres que no son letras
+    
+    TablaMapeo tabla;               ///< Mapeo de cada hipótesis
+    int candidatos;                 ///< Hipótesis (tamaño del rotor)
+    bool distinguible;              ///< Alguna hipótesis mapea distinto de otra
+    short puntajeBigrama[OTRO + 1][OTRO + 1];   ///< [anterior][actual]
+    unsigned char clase[256];       ///< Carácter -> letra 0..25 u OTRO
+    
+    long long* puntajes;            ///< Puntaje acumulado de cada hipótesis
+    unsigned char* previo;          ///< Clase del último carácter de cada hipótesis
+    long rotacion;                  ///< Rotación acumulada desde el inicio
+    
+    TramaBase** retenidas;          ///< Tramas a reprocesar tras decidir
+    int numRetenidas;               ///< Tramas retenidas
+    int ventana;                    ///< Tramas antes de decidir
+    
+    /**
+     * @brief Construye el modelo de letras y bigramas
+     */
+    void construirModelo();
+    
+    /**
+     * @brief Suma un carácter crudo al puntaje de todas las hipótesis
+     */
+    void puntuar(unsigned char c);
+
+public:
+    /**
+     * @brief Constructor
+     * @param rotor Rotor en su estado actual (la hipótesis k es rotarlo k)
+     * @param ventanaTramas Tramas a observar antes de decidir (> 0)
+     */
+    RecuperadorDesplazamiento(RotorDeMapeo* rotor, int ventanaTramas);
+    
+    /**
+     * @brief Destructor - Libera las tramas que no se devolvieron
+     */
+    ~RecuperadorDesplazamiento();
+    
+    RecuperadorDesplazamiento(const RecuperadorDesplazamiento&) = delete;
+    RecuperadorDesplazamiento& operator=(const RecuperadorDesplazamiento&) = delete;
+    
+    /**
+     * @brief Puntúa una trama bajo todas las hipótesis y la retiene
+     * @param trama Trama en orden (pasa a ser del recuperador)
+     * @return true si la ventana se completó y hay que decidir
+     */
+    bool retener(TramaBase* trama);
+    
+    /**
+     * @brief Indica si las hipótesis pueden dar puntajes distintos
+     * 
+     * Si el rotor mapea igual en todos los desplazamientos (por ejemplo,
+     * un mapeo identidad), todas las tablas coinciden y no hay nada que
+     * recuperar.
+     */
+    bool puedeDistinguir() const { return distinguible; }
+    
+    /**
+     * @brief Hipótesis con mayor puntaje (ante empate, la menor)
+     */
+    int getMejor() const;
+    
+    /**
+     * @brief Mejor puntaje entre las hipótesis distintas de getMejor()
+     */
+    int getSegundo() const;
+    
+    /**
+     * @brief Puntaje acumulado de una hipótesis
+     */
+    long long getPuntaje(int k) const { return puntajes[k]; }
+    
+    /**
+     * @brief Cantidad de hipótesis
+     */
+    int getCandidatos() const { return candidatos; }
+    
+    /**
+     * @brief Cantidad de tramas retenidas
+     */
+    int getNumRetenidas() const { return numRetenidas; }
+    
+    /**
+     * @brief Devuelve una trama retenida (la propiedad pasa a quien llama)
+     * @param i Índice en orden de llegada
+     */
+    TramaBase* tomarRetenida(int i);
+};
+
+#endif // RECUPERADOR_DESPLAZAMIENTO_H
@@ -4,13 +4,16 @@
 
 #include "RotorDeMapeo.h"
 #include <iostream>
+#include <new>
 
 // Constructor del nodo
 RotorDeMapeo::NodoRotor::NodoRotor(char c) 
     : dato(c), siguiente(nullptr), previo(nullptr) {}
 
-// Constructor de RotorDeMapeo
-RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
+// Constructor de RotorDeMapeo (una sola losa para los 26 nodos)
+RotorDeMapeo::RotorDeMapeo()
+    : cabeza(nullptr), tamanio(0), desplazamiento(0), pool(26),
+      tablasBloque(nullptr), tablaLista(nullptr) {
     // Inicializar con el alfabeto A-Z
     for(char c = 'A'; c <= 'Z'; c++) {
         insertarAlFinal(c);
@@ -19,25 +22,16 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
 
 // Destructor
 RotorDeMapeo::~RotorDeMapeo() {
-    if(!cabeza) return;
-    
-    NodoRotor* actual = cabeza;
-    NodoRotor* temp;
-    
-    // Romper el círculo para poder eliminar secuencialmente
-    cabeza->previo->siguiente = nullptr;
-    
-    // Eliminar todos los nodos
-    while(actual) {
-        temp = actual;
-        actual = actual->siguiente;
-        delete temp;
-    }
+    // NodoRotor es trivial: se devuelve la losa completa
+    pool.liberarTodo();
+    cabeza = nullptr;
+    delete[] tablasBloque;
+    delete[] tablaLista;
 }
 
 // Insertar al final (usado en construcción)
 void RotorDeMapeo::insertarAlFinal(char c) {
-    NodoRotor* nuevo = new NodoRotor(c);
+    NodoRotor* nuevo = new (pool.reservar()) NodoRotor(c);
     
     if(!cabeza) {
         // Primer nodo - apunta a sí mismo
@@ -63,6 +57,7 @@ void RotorDeMapeo::rotar(int n) {
     // Normalizar rotación (manejar valores mayores al tamaño)
     n = n % tamanio;
     if(n < 0) n += tamanio;  // Convertir negativos a equivalente positivo
+    desplazamiento = (desplazamiento + n) % tamanio;
     
     // Rotar moviendo la cabeza (eficiente O(n))
     for(int i = 0; i < n; i++) {
@@ -122,3 +117,41 @@ void RotorDeMapeo::imprimir() {
     } while(actual != cabeza);
     std::cout << "] (Cabeza en '" << cabeza->dato << "')" << std::endl;
 }
+
+// Rotación neta acumulada
+int RotorDeMapeo::getDesplazamiento() const {
+    return desplazamiento;
+}
+
+// Tamaño del rotor
+int RotorDeMapeo::getTamanio() const {
+    return tamanio;
+}
+
+// Tabla de mapeo para la rotación actual
+void RotorDeMapeo::construirTabla(char tabla[256]) {
+    for(int c = 0; c < 256; c++) {
+        tabla[c] = getMapeo((char)c);
+    }
+}
+
+// Mapear un bloque en una pasada
+void RotorDeMapeo::mapearBloque(const char* entrada, char* salida, int n) {
+    if(tamanio == 0) {
+        for(int i = 0; i < n; i++) salida[i] = entrada[i];
+        return;
+    }
+    if(!tablasBloque) {
+        tablasBloque = new char[tamanio][256];
+        tablaLista = new bool[tamanio]();
+    }
+    char* tabla = tablasBloque[desplazamiento];
+    if(!tablaLista[desplazamiento]) {
+        construirTabla(tabla);
+        tablaLista[desplazamiento] = true;
+    }
+    
+    for(int i = 0; i < n; i++) {
+        salida[i] = tabla[(unsigned char)entrada[i]];
+    }
+}
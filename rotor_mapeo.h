@@ -5,6 +5,8 @@
 #ifndef ROTOR_DE_MAPEO_H
 #define ROTOR_DE_MAPEO_H
 
+#include "PoolNodos.h"
+
 /**
  * @class RotorDeMapeo
  * @brief Lista circular doblemente enlazada que implementa un cifrado César dinámico
@@ -33,6 +35,10 @@ private:
     
     NodoRotor* cabeza;  ///< Puntero a la posición "cero" actual del rotor
     int tamanio;        ///< Cantidad de elementos en el rotor (26 para A-Z)
+    int desplazamiento; ///< Rotación neta acumulada (0..tamanio-1)
+    PoolNodos<NodoRotor> pool;  ///< Losa contigua con todos los nodos del rotor
+    char (*tablasBloque)[256];  ///< Tabla de cada desplazamiento para mapearBloque (perezosa)
+    bool* tablaLista;           ///< tablasBloque[d] ya se construyó
     
     /**
      * @brief Inserta un carácter al final de la lista circular
@@ -55,8 +61,8 @@ public:
     /**
      * @brief Destructor - Libera toda la memoria de los nodos
      * 
-     * Rompe el círculo y elimina todos los nodos secuencialmente
-     * para evitar memory leaks.
+     * Los nodos viven en la losa del pool, que se libera completa
+     * sin recorrer el círculo.
      */
     ~RotorDeMapeo();
     
@@ -92,6 +98,38 @@ public:
      * la posición actual de la cabeza.
      */
     void imprimir();
+    
+    /**
+     * @brief Rotación neta acumulada desde la construcción
+     * @return Posiciones que avanzó la cabeza, en el rango [0, tamanio)
+     */
+    int getDesplazamiento() const;
+    
+    /**
+     * @brief Cantidad de elementos del rotor
+     */
+    int getTamanio() const;
+    
+    /**
+     * @brief Vuelca el mapeo actual de los 256 bytes posibles
+     * @param tabla Arreglo de 256 posiciones: tabla[c] = getMapeo(c)
+     * 
+     * Permite decodificar muchos caracteres con la misma rotación
+     * consultando una tabla en vez de recorrer la lista circular.
+     */
+    void construirTabla(char tabla[256]);
+    
+    /**
+     * @brief Mapea un bloque completo con la rotación actual
+     * @param entrada Caracteres crudos
+     * @param salida Destino (puede ser igual a entrada)
+     * @param n Cantidad de caracteres
+     * 
+     * La tabla de cada desplazamiento se construye la primera vez que se
+     * usa y se conserva: el bloque se recorre una sola vez, con una
+     * consulta a la tabla por byte, sin tocar la lista circular.
+     */
+    void mapearBloque(const char* entrada, char* salida, int n);
 };
 
 #endif // ROTOR_DE_MAPEO_H
@@ -4,9 +4,11 @@
 
 #include "SerialPort.h"
 #include <iostream>
+#include <cstring>
 
 // Constructor
-SerialPort::SerialPort(const char* nombrePuerto) : conectado(false) {
+SerialPort::SerialPort(const char* nombrePuerto)
+    : conectado(false), sondeo(false), largoPendiente(0) {
 #ifdef _WIN32
     // ===== WINDOWS: API Win32 =====
     puerto = CreateFileA(nombrePuerto,
@@ -45,7 +47,7 @@ SerialPort::SerialPort(const char* nombrePuerto) : conectado(false) {
     timeouts.ReadTotalTimeoutMultiplier = 10;
     
     SetCommTimeouts(puerto, &timeouts);
-    
+
 #else
     // ===== LINUX: API POSIX =====
     puerto = open(nombrePuerto, O_RDWR | O_NOCTTY | O_SYNC);
@@ -81,7 +83,7 @@ SerialPort::SerialPort(const char* nombrePuerto) : conectado(false) {
     
     tcsetattr(puerto, TCSANOW, &tty);
 #endif
-    
+
     conectado = true;
     std::cout << "Conexión establecida. Esperando tramas...\n" << std::endl;
 }
@@ -103,6 +105,13 @@ bool SerialPort::leerLinea(char* buffer, int maxLen) {
     
     int pos = 0;
     
+    if(sondeo && largoPendiente > 0) {
+        // Retomar la línea que quedó a medias en la llamada anterior
+        pos = largoPendiente < maxLen - 1 ? largoPendiente : maxLen - 1;
+        memcpy(buffer, pendiente, pos);
+        largoPendiente = 0;
+    }
+
 #ifdef _WIN32
     // ===== WINDOWS =====
     DWORD leidos;
@@ -110,6 +119,10 @@ bool SerialPort::leerLinea(char* buffer, int maxLen) {
     
     while(pos < maxLen - 1) {
         if(!ReadFile(puerto, &c, 1, &leidos, nullptr) || leidos == 0) {
+            if(sondeo) {
+                guardarPendiente(buffer, pos);
+                return false;   // Sin datos por ahora
+            }
             if(pos > 0) break;  // Tenemos datos parciales
             return false;        // No hay datos
         }
@@ -122,7 +135,7 @@ bool SerialPort::leerLinea(char* buffer, int maxLen) {
         
         buffer[pos++] = c;
     }
-    
+
 #else
     // ===== LINUX =====
     char c;
@@ -131,6 +144,10 @@ bool SerialPort::leerLinea(char* buffer, int maxLen) {
         int n = read(puerto, &c, 1);
         
         if(n <= 0) {
+            if(sondeo) {
+                guardarPendiente(buffer, pos);
+                return false;   // Sin datos por ahora
+            }
             if(pos > 0) break;  // Tenemos datos parciales
             return false;        // No hay datos
         }
@@ -144,11 +161,45 @@ bool SerialPort::leerLinea(char* buffer, int maxLen) {
         buffer[pos++] = c;
     }
 #endif
-    
+
     buffer[pos] = '\0';
     return pos > 0;
 }
 
+// Guardar la línea incompleta para la próxima lectura
+void SerialPort::guardarPendiente(const char* buffer, int pos) {
+    if(pos > MAX_PENDIENTE) pos = MAX_PENDIENTE;
+    memcpy(pendiente, buffer, pos);
+    largoPendiente = pos;
+}
+
+// Cambiar entre lectura con timeout y sondeo activo
+bool SerialPort::setSondeoActivo(bool activo) {
+    if(!conectado) return false;
+
+#ifdef _WIN32
+    COMMTIMEOUTS timeouts = {0};
+    if(activo) {
+        timeouts.ReadIntervalTimeout = MAXDWORD;    // Retornar de inmediato
+    } else {
+        timeouts.ReadIntervalTimeout = 50;
+        timeouts.ReadTotalTimeoutConstant = 50;
+        timeouts.ReadTotalTimeoutMultiplier = 10;
+    }
+    if(!SetCommTimeouts(puerto, &timeouts)) return false;
+#else
+    struct termios tty;
+    if(tcgetattr(puerto, &tty) != 0) return false;
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = activo ? 0 : 5;
+    if(tcsetattr(puerto, TCSANOW, &tty) != 0) return false;
+#endif
+
+    sondeo = activo;
+    if(!activo) largoPendiente = 0;
+    return true;
+}
+
 // Verificar estado de conexión
 bool SerialPort::estaConectado() const {
     return conectado;
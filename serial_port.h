@@ -29,7 +29,17 @@ private:
     int puerto;         ///< File descriptor del puerto en Linux
 #endif
     bool conectado;     ///< Estado de la conexión
+    bool sondeo;        ///< Lecturas que retornan de inmediato (sondeo activo)
     
+    static const int MAX_PENDIENTE = 2048;  ///< Tope de la línea a medias (una trama B completa)
+    char pendiente[MAX_PENDIENTE];          ///< Línea incompleta entre llamadas
+    int largoPendiente;                     ///< Caracteres en pendiente
+    
+    /**
+     * @brief Guarda la línea incompleta para la próxima lectura
+     */
+    void guardarPendiente(const char* buffer, int pos);
+
 public:
     /**
      * @brief Constructor - Abre y configura el puerto serial
@@ -62,6 +72,19 @@ public:
      */
     bool leerLinea(char* buffer, int maxLen);
     
+    /**
+     * @brief Activa o desactiva el sondeo activo (busy-poll)
+     * @param activo true para que cada lectura retorne sin esperar
+     * @return true si el puerto aceptó la configuración
+     * 
+     * Sin sondeo, una lectura espera hasta 0.5 s por el siguiente byte.
+     * Con sondeo (VMIN=0, VTIME=0) leerLinea() retorna false en cuanto no
+     * hay datos, y la línea que quedó a medias se conserva para la próxima
+     * llamada en lugar de entregarse incompleta. El llamador decide cuándo
+     * volver a intentar (ej: en un bucle sin pausas).
+     */
+    bool setSondeoActivo(bool activo);
+    
     /**
      * @brief Verifica si la conexión está activa
      * @return true si el puerto está conectado y listo, false en caso contrario
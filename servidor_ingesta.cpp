@@ -0,0 +1,290 @@
+// ============================================================================
+// ServidorIngesta.cpp - Implementación del Servidor de Flujos
+// ============================================================================
+
+#include "ServidorIngesta.h"
+#include <iostream>
+
+#ifdef __linux__
+
+#include "SesionDecodificador.h"
+#include "Traza.h"
+#include <mutex>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/**
+ * @struct Conexion
+ * @brief Cliente aceptado, enlazado en la lista de su bucle
+ */
+struct Conexion {
+    int fd;                     ///< Socket del cliente
+    unsigned long id;           ///< Número de conexión
+    SesionDecodificador sesion; ///< Estado de decodificación propio
+    Conexion* siguiente;        ///< Siguiente conexión del bucle
+    Conexion* previo;           ///< Conexión anterior del bucle
+};
+
+// Serializa los resúmenes de sesión de varios bucles
+static std::mutex mutexSalida;
+
+// Resumen de una sesión al cerrarse
+static void imprimirSesion(Conexion* c) {
+    char mensaje[65];
+    int n = c->sesion.getCarga().copiarMensaje(mensaje, 64);
+    mensaje[n] = '\0';
+    
+    std::lock_guard<std::mutex> lock(mutexSalida);
+    std::cout << "[SESION " << c->id << "] " << c->sesion.getTramas() << " tramas, "
+              << c->sesion.getMalformadas() << " mal formadas: " << mensaje
+              << (c->sesion.getCarga().getLongitud() > 64 ? "..." : "") << std::endl;
+}
+
+// Constructor
+ServidorIngesta::ServidorIngesta(const ConfigServidor& cfg)
+    : config(cfg), escuchaUnix(-1), hilos(nullptr), activo(false),
+      activas(0), aceptadas(0), tramas(0), bytes(0) {
+    if(config.hilos < 1) config.hilos = 1;
+}
+
+// Destructor
+ServidorIngesta::~ServidorIngesta() {
+    detener();
+}
+
+// Escucha TCP (una por bucle, repartidas por SO_REUSEPORT)
+int ServidorIngesta::crearEscuchaTcp() {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0) return -1;
+    
+    int uno = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &uno, sizeof(uno));
+    
+    struct sockaddr_in dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sin_family = AF_INET;
+    dir.sin_port = htons((unsigned short)config.puertoTcp);
+    dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if(bind(fd, (struct sockaddr*)&dir, sizeof(dir)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Escucha UNIX (compartida por todos los bucles)
+int ServidorIngesta::crearEscuchaUnix() {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd < 0) return -1;
+    
+    struct sockaddr_un dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    strncpy(dir.sun_path, config.rutaUnix, sizeof(dir.sun_path) - 1);
+    unlink(config.rutaUnix);
+    
+    if(bind(fd, (struct sockaddr*)&dir, sizeof(dir)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Abrir escuchas y lanzar bucles
+bool ServidorIngesta::iniciar() {
+    if(hilos) return true;
+    
+    // Miles de clientes: subir el límite blando de descriptores al duro
+    struct rlimit lim;
+    if(getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+        lim.rlim_cur = lim.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+    
+    int* escuchas = new int[config.hilos];
+    bool ok = true;
+    
+    if(config.rutaUnix) {
+        escuchaUnix = crearEscuchaUnix();
+        ok = escuchaUnix >= 0;
+        for(int i = 0; i < config.hilos; i++) escuchas[i] = escuchaUnix;
+    } else {
+        for(int i = 0; i < config.hilos; i++) {
+            escuchas[i] = ok ? crearEscuchaTcp() : -1;
+            if(escuchas[i] < 0) ok = false;
+        }
+    }
+    
+    if(!ok) {
+        std::cerr << "Error al abrir el socket de escucha: " << strerror(errno) << std::endl;
+        if(!config.rutaUnix) {
+            for(int i = 0; i < config.hilos; i++) if(escuchas[i] >= 0) close(escuchas[i]);
+        } else if(escuchaUnix >= 0) {
+            close(escuchaUnix);
+            escuchaUnix = -1;
+        }
+        delete[] escuchas;
+        return false;
+    }
+    
+    activo = true;
+    hilos = new std::thread[config.hilos];
+    for(int i = 0; i < config.hilos; i++) {
+        hilos[i] = std::thread(&ServidorIngesta::bucle, this, escuchas[i]);
+    }
+    delete[] escuchas;
+    return true;
+}
+
+// Detener bucles
+void ServidorIngesta::detener() {
+    if(!hilos) return;
+    
+    activo = false;
+    for(int i = 0; i < config.hilos; i++) {
+        if(hilos[i].joinable()) hilos[i].join();
+    }
+    delete[] hilos;
+    hilos = nullptr;
+    
+    if(escuchaUnix >= 0) {
+        close(escuchaUnix);
+        unlink(config.rutaUnix);
+        escuchaUnix = -1;
+    }
+}
+
+// Bucle de eventos edge-triggered
+void ServidorIngesta::bucle(int escucha) {
+    TRAZA_HILO("epoll");
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    
+    struct epoll_event ev;
+    ev.data.ptr = nullptr;      // nullptr identifica al socket de escucha
+    ev.events = config.rutaUnix ? (EPOLLIN | EPOLLEXCLUSIVE) : (EPOLLIN | EPOLLET);
+    epoll_ctl(ep, EPOLL_CTL_ADD, escucha, &ev);
+    
+    const int MAX_EVENTOS = 256;
+    struct epoll_event eventos[MAX_EVENTOS];
+    const int TAM_BUFFER = 64 * 1024;
+    char* buffer = new char[TAM_BUFFER];
+    
+    Conexion* conexiones = nullptr;     // Lista doble de conexiones del bucle
+    
+    while(activo) {
+        int n = epoll_wait(ep, eventos, MAX_EVENTOS, 200);
+        
+        for(int e = 0; e < n; e++) {
+            Conexion* c = static_cast<Conexion*>(eventos[e].data.ptr);
+            
+            if(!c) {
+                // Aceptar hasta vaciar la cola (obligatorio en edge-triggered)
+                while(true) {
+                    int fd = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if(fd < 0) break;
+                    
+                    Conexion* nueva = new Conexion();
+                    nueva->fd = fd;
+                    nueva->id = ++aceptadas;
+                    nueva->sesion.configurar(config.desplazamiento, config.estricto);
+                    nueva->previo = nullptr;
+                    nueva->siguiente = conexiones;
+                    if(conexiones) conexiones->previo = nueva;
+                    conexiones = nueva;
+                    activas++;
+                    
+                    struct epoll_event evc;
+                    evc.events = EPOLLIN | EPOLLET | EPOLLRDHUP;
+                    evc.data.ptr = nueva;
+                    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &evc);
+                }
+                continue;
+            }
+            
+            // Leer hasta EAGAIN (edge-triggered)
+            bool cerrar = false;
+            unsigned long tramasAntes = c->sesion.getTramas();
+            unsigned long leidos = 0;
+            
+            while(true) {
+                TRAZA_MARCA(inicioLectura);
+                ssize_t r = read(c->fd, buffer, TAM_BUFFER);
+                if(r > 0) {
+                    TRAZA_CERRAR("leer", inicioLectura);
+                    c->sesion.alimentar(buffer, (int)r);
+                    leidos += (unsigned long)r;
+                } else if(r == 0) {
+                    cerrar = true;
+                    break;
+                } else if(errno == EINTR) {
+                    continue;
+                } else {
+                    if(errno != EAGAIN && errno != EWOULDBLOCK) cerrar = true;
+                    break;
+                }
+            }
+            
+            if(cerrar) c->sesion.finalizar();
+            tramas.fetch_add(c->sesion.getTramas() - tramasAntes, std::memory_order_relaxed);
+            bytes.fetch_add(leidos, std::memory_order_relaxed);
+            
+            if(cerrar) {
+                if(config.mostrarSesiones) imprimirSesion(c);
+                
+                epoll_ctl(ep, EPOLL_CTL_DEL, c->fd, nullptr);
+                close(c->fd);
+                if(c->previo) c->previo->siguiente = c->siguiente;
+                else conexiones = c->siguiente;
+                if(c->siguiente) c->siguiente->previo = c->previo;
+                delete c;
+                activas--;
+            }
+        }
+    }
+    
+    // Cerrar las sesiones que sigan abiertas
+    while(conexiones) {
+        Conexion* c = conexiones;
+        conexiones = c->siguiente;
+        close(c->fd);
+        delete c;
+        activas--;
+    }
+    
+    delete[] buffer;
+    if(!config.rutaUnix) close(escucha);
+    close(ep);
+}
+
+#else
+// ===== SIN EPOLL: modo servidor no disponible =====
+
+ServidorIngesta::ServidorIngesta(const ConfigServidor& cfg)
+    : config(cfg), escuchaUnix(-1), hilos(nullptr), activo(false),
+      activas(0), aceptadas(0), tramas(0), bytes(0) {}
+
+ServidorIngesta::~ServidorIngesta() {}
+
+int ServidorIngesta::crearEscuchaTcp() { return -1; }
+int ServidorIngesta::crearEscuchaUnix() { return -1; }
+void ServidorIngesta::bucle(int) {}
+
+bool ServidorIngesta::iniciar() {
+    std::cerr << "El modo servidor requiere Linux (epoll)" << std::endl;
+    return false;
+}
+
+void ServidorIngesta::detener() {}
+
+#endif // __linux__
@@ -0,0 +1,98 @@
+// ============================================================================
+// ServidorIngesta.h - Servidor de Flujos PRT-7 por Sockets (epoll)
+// ============================================================================
+
+#ifndef SERVIDOR_INGESTA_H
+#define SERVIDOR_INGESTA_H
+
+#include <thread>
+#include <atomic>
+
+/**
+ * @struct ConfigServidor
+ * @brief Parámetros del modo servidor
+ */
+struct ConfigServidor {
+    const char* rutaUnix;   ///< Socket UNIX donde escuchar (o nullptr)
+    int puertoTcp;          ///< Puerto TCP en 127.0.0.1 (si rutaUnix es nullptr)
+    int hilos;              ///< Bucles de eventos (uno por núcleo)
+    bool mostrarSesiones;   ///< Imprimir un resumen al cerrar cada sesión
+    int desplazamiento;     ///< Rotación inicial del rotor de cada sesión
+    bool estricto;          ///< Parser en modo estricto
+};
+
+/**
+ * @class ServidorIngesta
+ * @brief Acepta muchos clientes concurrentes, cada uno con su sesión
+ * 
+ * Cada cliente que se conecta recibe su propia SesionDecodificador
+ * (ListaDeCarga + RotorDeMapeo). Los sockets se atienden con bucles
+ * epoll en modo edge-triggered, uno por hilo:
+ * - TCP: cada bucle tiene su propio socket de escucha con SO_REUSEPORT
+ *   y el kernel reparte las conexiones entre ellos.
+ * - UNIX: los bucles comparten el socket de escucha registrado con
+ *   EPOLLEXCLUSIVE, para que cada conexión despierte a un solo bucle.
+ * 
+ * Una conexión vive siempre en el bucle que la aceptó, así que las
+ * sesiones no necesitan sincronización. Sólo disponible en Linux.
+ */
+class ServidorIngesta {
+private:
+    ConfigServidor config;      ///< Parámetros de arranque
+    int escuchaUnix;            ///< Socket de escucha compartido (modo UNIX)
+    std::thread* hilos;         ///< Un hilo por bucle de eventos
+    std::atomic<bool> activo;   ///< false para detener los bucles
+    
+    std::atomic<unsigned long> activas;     ///< Conexiones abiertas
+    std::atomic<unsigned long> aceptadas;   ///< Conexiones aceptadas en total
+    std::atomic<unsigned long> tramas;      ///< Tramas procesadas en total
+    std::atomic<unsigned long> bytes;       ///< Bytes recibidos en total
+    
+    /**
+     * @brief Crea un socket de escucha TCP en loopback con SO_REUSEPORT
+     * @return Descriptor o -1 si hay error
+     */
+    int crearEscuchaTcp();
+    
+    /**
+     * @brief Crea el socket de escucha UNIX
+     * @return Descriptor o -1 si hay error
+     */
+    int crearEscuchaUnix();
+    
+    /**
+     * @brief Cuerpo de un bucle de eventos
+     * @param escucha Socket de escucha de este bucle
+     */
+    void bucle(int escucha);
+
+public:
+    /**
+     * @brief Constructor - Guarda la configuración
+     * @param cfg Parámetros del servidor
+     */
+    explicit ServidorIngesta(const ConfigServidor& cfg);
+    
+    /**
+     * @brief Destructor - Detiene los bucles y cierra los sockets
+     */
+    ~ServidorIngesta();
+    
+    /**
+     * @brief Abre los sockets de escucha y lanza los bucles
+     * @return true si el servidor quedó escuchando
+     */
+    bool iniciar();
+    
+    /**
+     * @brief Detiene los bucles y cierra todas las sesiones
+     */
+    void detener();
+    
+    unsigned long getActivas() const { return activas; }     ///< Conexiones abiertas
+    unsigned long getAceptadas() const { return aceptadas; } ///< Conexiones totales
+    unsigned long getTramas() const { return tramas; }       ///< Tramas procesadas
+    unsigned long getBytes() const { return bytes; }         ///< Bytes recibidos
+};
+
+#endif // SERVIDOR_INGESTA_H
@@ -0,0 +1,61 @@
+// ============================================================================
+// SesionDecodificador.cpp - Implementación de una Sesión de Decodificación
+// ============================================================================
+
+#include "SesionDecodificador.h"
+#include "ParserTramas.h"
+#include "Traza.h"
+
+// Constructor
+SesionDecodificador::SesionDecodificador()
+    : largo(0), desbordada(false), estricto(false), tramas(0), malformadas(0) {}
+
+// Rotación inicial y modo del parser
+void SesionDecodificador::configurar(int desplazamiento, bool parserEstricto) {
+    if(desplazamiento != 0) rotor.rotar(desplazamiento);
+    estricto = parserEstricto;
+}
+
+// Armar líneas y procesarlas
+void SesionDecodificador::alimentar(const char* datos, int n) {
+    for(int i = 0; i < n; i++) {
+        char c = datos[i];
+        
+        if(c == '\n' || c == '\r') {
+            if(largo > 0 || desbordada) procesarLinea();
+            continue;
+        }
+        
+        if(largo < LARGO_LINEA - 1) {
+            linea[largo++] = c;
+        } else {
+            desbordada = true;
+        }
+    }
+}
+
+// Última línea sin terminador
+void SesionDecodificador::finalizar() {
+    if(largo > 0 || desbordada) procesarLinea();
+}
+
+// Parsear y procesar una línea
+void SesionDecodificador::procesarLinea() {
+    linea[largo] = '\0';
+    TRAZA_MARCA(inicioParseo);
+    TramaBase* trama = desbordada ? nullptr : parsearTrama(linea, estricto);
+    TRAZA_CERRAR("parsear", inicioParseo);
+    largo = 0;
+    desbordada = false;
+    
+    if(!trama) {
+        malformadas++;
+        return;
+    }
+    
+    tramas++;
+    carga.setTramaActual(tramas);
+    TRAZA_INTERVALO("procesar");
+    trama->procesar(&carga, &rotor);
+    delete trama;
+}
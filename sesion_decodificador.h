@@ -0,0 +1,78 @@
+// ============================================================================
+// SesionDecodificador.h - Estado de Decodificación de un Flujo Independiente
+// ============================================================================
+
+#ifndef SESION_DECODIFICADOR_H
+#define SESION_DECODIFICADOR_H
+
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "ParserTramas.h"
+
+/**
+ * @class SesionDecodificador
+ * @brief Un flujo PRT-7 con su propia ListaDeCarga y su propio RotorDeMapeo
+ * 
+ * Recibe bytes crudos en trozos arbitrarios (como llegan de un socket o
+ * de un archivo), arma las líneas, las parsea y procesa cada trama. Varias
+ * sesiones pueden convivir en el mismo proceso sin compartir estado.
+ */
+class SesionDecodificador {
+private:
+    static const int LARGO_LINEA = LARGO_MAX_LINEA; ///< Tamaño máximo de una línea
+    
+    ListaDeCarga carga;         ///< Mensaje ensamblado de la sesión
+    RotorDeMapeo rotor;         ///< Rotor propio de la sesión
+    char linea[LARGO_LINEA];    ///< Línea en armado
+    int largo;                  ///< Caracteres acumulados en 'linea'
+    bool desbordada;            ///< La línea actual excedió LARGO_LINEA
+    bool estricto;              ///< Parser en modo estricto
+    
+    unsigned long tramas;       ///< Tramas válidas procesadas
+    unsigned long malformadas;  ///< Líneas que no son tramas válidas
+    
+    /**
+     * @brief Parsea y procesa la línea acumulada
+     */
+    void procesarLinea();
+
+public:
+    /**
+     * @brief Constructor - Sesión vacía con el rotor en 'A'
+     */
+    SesionDecodificador();
+    
+    /**
+     * @brief Ajusta la decodificación antes de alimentar datos
+     * @param desplazamiento Rotación inicial del rotor
+     * @param parserEstricto true para el modo estricto de parsearTrama()
+     */
+    void configurar(int desplazamiento, bool parserEstricto);
+    
+    /**
+     * @brief Entrega bytes recibidos
+     * @param datos Bytes crudos (pueden cortar líneas a la mitad)
+     * @param n Cantidad de bytes
+     */
+    void alimentar(const char* datos, int n);
+    
+    /**
+     * @brief Procesa la última línea si el flujo terminó sin '\n'
+     */
+    void finalizar();
+    
+    /**
+     * @brief Lista con el mensaje ensamblado
+     */
+    ListaDeCarga& getCarga() { return carga; }
+    
+    /**
+     * @brief Rotor de la sesión
+     */
+    RotorDeMapeo& getRotor() { return rotor; }
+    
+    unsigned long getTramas() const { return tramas; }             ///< Tramas procesadas
+    unsigned long getMalformadas() const { return malformadas; }   ///< Líneas inválidas
+};
+
+#endif // SESION_DECODIFICADOR_H
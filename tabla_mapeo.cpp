@@ -0,0 +1,22 @@
+// ============================================================================
+// TablaMapeo.cpp - Construcción de las Tablas por Desplazamiento
+// ============================================================================
+
+#include "TablaMapeo.h"
+
+// Constructor: una vuelta completa del rotor
+TablaMapeo::TablaMapeo(RotorDeMapeo* rotor) {
+    tamanio = rotor->getTamanio() > 0 ? rotor->getTamanio() : 1;
+    tablas = new char[tamanio][256];
+    
+    for(int k = 0; k < tamanio; k++) {
+        rotor->construirTabla(tablas[k]);
+        rotor->rotar(1);
+    }
+    // Tras 'tamanio' rotaciones de 1 el rotor vuelve a su estado original
+}
+
+// Destructor
+TablaMapeo::~TablaMapeo() {
+    delete[] tablas;
+}
@@ -0,0 +1,71 @@
+// ============================================================================
+// TablaMapeo.h - Tablas Precalculadas del Rotor por Desplazamiento
+// ============================================================================
+
+#ifndef TABLA_MAPEO_H
+#define TABLA_MAPEO_H
+
+#include "RotorDeMapeo.h"
+
+/**
+ * @class TablaMapeo
+ * @brief Mapeo del rotor para cada desplazamiento posible, en tablas
+ * 
+ * Se construye una sola vez a partir de un RotorDeMapeo: para cada
+ * desplazamiento k (relativo al estado del rotor al construir) guarda la
+ * tabla de 256 bytes que produce getMapeo() tras rotar k posiciones.
+ * Así se puede decodificar un carácter con cualquier rotación sin mover
+ * la cabeza ni recorrer la lista circular.
+ */
+class TablaMapeo {
+private:
+    char (*tablas)[256];    ///< Una tabla de 256 bytes por desplazamiento
+    int tamanio;            ///< Cantidad de desplazamientos distintos
+
+public:
+    /**
+     * @brief Constructor - Precalcula las tablas de un rotor
+     * @param rotor Rotor de referencia (se rota una vuelta completa y
+     *              queda en el mismo estado)
+     */
+    explicit TablaMapeo(RotorDeMapeo* rotor);
+    
+    /**
+     * @brief Destructor - Libera las tablas
+     */
+    ~TablaMapeo();
+    
+    TablaMapeo(const TablaMapeo&) = delete;
+    TablaMapeo& operator=(const TablaMapeo&) = delete;
+    
+    /**
+     * @brief Cantidad de desplazamientos distintos (tamaño del rotor)
+     */
+    int getTamanio() const { return tamanio; }
+    
+    /**
+     * @brief Normaliza un desplazamiento al rango [0, tamanio)
+     * @param desplazamiento Rotación acumulada (puede ser negativa)
+     */
+    int normalizar(long desplazamiento) const {
+        long d = desplazamiento % tamanio;
+        return (int)(d < 0 ? d + tamanio : d);
+    }
+    
+    /**
+     * @brief Tabla completa para un desplazamiento ya normalizado
+     * @param desplazamiento Valor en [0, tamanio)
+     */
+    const char* tabla(int desplazamiento) const { return tablas[desplazamiento]; }
+    
+    /**
+     * @brief Decodifica un carácter con un desplazamiento dado
+     * @param desplazamiento Rotación relativa al rotor de referencia
+     * @param c Carácter crudo
+     */
+    char mapear(long desplazamiento, char c) const {
+        return tablas[normalizar(desplazamiento)][(unsigned char)c];
+    }
+};
+
+#endif // TABLA_MAPEO_H
@@ -0,0 +1,99 @@
+// ============================================================================
+// TiempoReal.cpp - Implementación del Modo de Baja Latencia
+// ============================================================================
+
+#include "TiempoReal.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+// Bytes de pila que se tocan tras bloquear la memoria
+static const size_t PILA_PREFALLADA = 256 * 1024;
+
+// Escribir la pila por debajo del marco actual para asignar sus páginas
+static void prefallarPila() {
+    char relleno[PILA_PREFALLADA];
+    volatile char* p = relleno;     // Escrituras que el compilador no puede quitar
+    for(size_t i = 0; i < PILA_PREFALLADA; i += 4096) p[i] = 0;
+}
+
+// Núcleos en línea que caben en un cpu_set_t
+int nucleosDisponibles() {
+#ifdef __linux__
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if(n > CPU_SETSIZE) n = CPU_SETSIZE;
+#else
+    long n = (long)std::thread::hardware_concurrency();
+#endif
+    return n > 0 ? (int)n : 1;
+}
+
+// Aplicar el modo al hilo actual
+bool aplicarTiempoReal(const ConfigTiempoReal& cfg) {
+    bool ok = true;
+    
+    if(cfg.nucleo >= 0) {
+#ifdef __linux__
+        if(cfg.nucleo >= nucleosDisponibles()) {
+            // CPU_SET fuera de rango escribiría más allá del cpu_set_t
+            std::cerr << "[WARN] Núcleo " << cfg.nucleo << " fuera de rango (hay "
+                      << nucleosDisponibles() << " disponibles)" << std::endl;
+            ok = false;
+        } else {
+            cpu_set_t conjunto;
+            CPU_ZERO(&conjunto);
+            CPU_SET(cfg.nucleo, &conjunto);
+            if(sched_setaffinity(0, sizeof(conjunto), &conjunto) != 0) {
+                std::cerr << "[WARN] No se pudo fijar el hilo al núcleo " << cfg.nucleo
+                          << ": " << strerror(errno) << std::endl;
+                ok = false;
+            }
+        }
+#else
+        std::cerr << "[WARN] La afinidad de núcleo sólo está disponible en Linux" << std::endl;
+        ok = false;
+#endif
+    }
+    
+    if(cfg.prioridadFifo > 0) {
+#ifdef __linux__
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = cfg.prioridadFifo;
+        if(sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+            std::cerr << "[WARN] No se pudo activar SCHED_FIFO (prioridad "
+                      << cfg.prioridadFifo << "): " << strerror(errno) << std::endl;
+            ok = false;
+        }
+#else
+        std::cerr << "[WARN] SCHED_FIFO sólo está disponible en Linux" << std::endl;
+        ok = false;
+#endif
+    }
+    
+    if(cfg.bloquearMemoria) {
+#ifndef _WIN32
+        if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            std::cerr << "[WARN] No se pudo bloquear la memoria (mlockall): "
+                      << strerror(errno) << std::endl;
+            ok = false;
+        }
+#else
+        std::cerr << "[WARN] mlockall no está disponible en Windows" << std::endl;
+        ok = false;
+#endif
+        prefallarPila();
+    }
+    
+    return ok;
+}
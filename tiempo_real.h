@@ -0,0 +1,48 @@
+// ============================================================================
+// TiempoReal.h - Modo de Baja Latencia (Afinidad, SCHED_FIFO, mlockall)
+// ============================================================================
+
+#ifndef TIEMPO_REAL_H
+#define TIEMPO_REAL_H
+
+#include <cstddef>
+
+/**
+ * @struct ConfigTiempoReal
+ * @brief Ajustes del modo de baja latencia para el hilo decodificador
+ */
+struct ConfigTiempoReal {
+    int nucleo;             ///< Núcleo al que se fija el hilo (-1 = sin fijar)
+    int prioridadFifo;      ///< Prioridad SCHED_FIFO, 1-99 (0 = política normal)
+    bool bloquearMemoria;   ///< mlockall() de lo actual y lo futuro
+};
+
+/**
+ * @brief Aplica el modo de baja latencia al hilo que llama
+ * @param cfg Ajustes a aplicar
+ * @return true si se aplicó todo lo pedido
+ * 
+ * La variación de latencia en los equipos de control viene de que el
+ * planificador desaloje al hilo y de los fallos de página, no de la
+ * decodificación. Esta función:
+ * - Fija el hilo a un núcleo (sched_setaffinity), para no migrar ni
+ *   perder la caché.
+ * - Pide SCHED_FIFO, para que sólo lo desaloje un hilo de mayor prioridad.
+ * - Bloquea la memoria del proceso (mlockall) y toca de antemano la pila,
+ *   para que nada de lo ya reservado vuelva a fallar.
+ * 
+ * Cada ajuste que falle (ej: sin CAP_SYS_NICE o por RLIMIT_MEMLOCK) se
+ * informa por cerr y los demás se aplican igual. Las estructuras de datos
+ * deben prerreservarse antes de llamarla (ListaDeCarga::prereservar).
+ * La afinidad y SCHED_FIFO sólo existen en Linux.
+ */
+bool aplicarTiempoReal(const ConfigTiempoReal& cfg);
+
+/**
+ * @brief Cantidad de núcleos a los que se puede fijar un hilo
+ * @return Núcleos en línea (a lo sumo CPU_SETSIZE en Linux); los válidos
+ *         para ConfigTiempoReal::nucleo van de 0 a este valor menos 1
+ */
+int nucleosDisponibles();
+
+#endif // TIEMPO_REAL_H
@@ -0,0 +1,8 @@
+// ============================================================================
+// TramaBase.cpp - Estado Compartido de las Tramas
+// ============================================================================
+
+#include "TramaBase.h"
+
+// Por defecto se muestra el detalle de cada trama (modo interactivo)
+bool TramaBase::detalle = true;
@@ -14,11 +14,21 @@ class RotorDeMapeo;
  * @brief Clase base abstracta para todas las tramas del protocolo PRT-7
  * 
  * Define la interfaz común que deben implementar todas las tramas
- * (TramaLoad y TramaMap). El uso de polimorfismo permite procesar
+ * (TramaLoad, TramaMap y TramaCargaMasiva). El uso de polimorfismo permite procesar
  * cualquier tipo de trama a través de un puntero a la clase base.
  */
 class TramaBase {
+protected:
+    unsigned long secuencia;    ///< Número de secuencia de la trama (si lo trae)
+    bool conSecuencia;          ///< true si la trama llegó con número de secuencia
+    static bool detalle;        ///< Mostrar en consola el detalle de cada trama
+
 public:
+    /**
+     * @brief Constructor - Trama sin número de secuencia
+     */
+    TramaBase() : secuencia(0), conSecuencia(false) {}
+    
     /**
      * @brief Procesa la trama aplicando su lógica específica
      * @param carga Puntero a la lista donde se almacenan los datos decodificados
@@ -29,6 +39,12 @@ public:
      */
     virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
     
+    /**
+     * @brief Identifica el tipo de trama
+     * @return Letra del protocolo ('L' para carga, 'M' para mapeo, 'B' para carga masiva)
+     */
+    virtual char getTipo() const = 0;
+    
     /**
      * @brief Destructor virtual para limpieza polimórfica correcta
      * 
@@ -36,6 +52,35 @@ public:
      * delete sobre un puntero TramaBase* que apunta a objetos derivados.
      */
     virtual ~TramaBase() {}
+    
+    /**
+     * @brief Asigna el número de secuencia recibido en la trama
+     * @param n Número de secuencia (prefijo "n:" en el protocolo)
+     */
+    void setSecuencia(unsigned long n) { secuencia = n; conSecuencia = true; }
+    
+    /**
+     * @brief Indica si la trama llegó con número de secuencia
+     */
+    bool tieneSecuencia() const { return conSecuencia; }
+    
+    /**
+     * @brief Número de secuencia de la trama (válido si tieneSecuencia())
+     */
+    unsigned long getSecuencia() const { return secuencia; }
+    
+    /**
+     * @brief Activa o desactiva el detalle por trama en consola
+     * @param activo false para procesar en silencio (servidor, lotes)
+     * 
+     * Se fija al arrancar, antes de lanzar hilos de procesamiento.
+     */
+    static void setDetalle(bool activo) { detalle = activo; }
+    
+    /**
+     * @brief Indica si procesar() muestra el detalle de cada trama
+     */
+    static bool getDetalle() { return detalle; }
 };
 
 #endif // TRAMA_BASE_H
@@ -0,0 +1,62 @@
+// ============================================================================
+// TramaCargaMasiva.cpp - Implementación de Trama de Carga Masiva
+// ============================================================================
+
+#include "TramaCargaMasiva.h"
+#include "Traza.h"
+#include <iostream>
+#include <cstring>
+
+// Reserva desde el pool del hilo
+void* TramaCargaMasiva::operator new(size_t tam) {
+    if(tam != sizeof(TramaCargaMasiva)) return ::operator new(tam);
+    return PoolNodos<TramaCargaMasiva>::delHilo().reservar();
+}
+
+// Devolución al pool del hilo
+void TramaCargaMasiva::operator delete(void* p, size_t tam) {
+    if(tam != sizeof(TramaCargaMasiva)) {
+        ::operator delete(p);
+        return;
+    }
+    PoolNodos<TramaCargaMasiva>::delHilo().liberar(p);
+}
+
+// Estadísticas del pool
+const EstadisticasPool& TramaCargaMasiva::getEstadisticasPool() {
+    return PoolNodos<TramaCargaMasiva>::delHilo().getEstadisticas();
+}
+
+// Prerreserva en el pool del hilo
+void TramaCargaMasiva::prereservarPool(size_t n) {
+    PoolNodos<TramaCargaMasiva>::delHilo().prereservar(n);
+}
+
+// Constructor
+TramaCargaMasiva::TramaCargaMasiva(const char* datos, int n) : largo(n) {
+    if(n > 0) memcpy(carga, datos, n);
+}
+
+// Procesar trama de carga masiva
+void TramaCargaMasiva::procesar(ListaDeCarga* lista, RotorDeMapeo* rotor) {
+    // Decodificar todo el bloque con la rotación actual y agregarlo de una vez
+    char decodificado[MAX_CARGA];
+    rotor->mapearBloque(carga, decodificado, largo);
+    lista->insertarBloque(decodificado, largo);
+    if(!detalle) return;
+    
+    // Mostrar información de debug
+    TRAZA_INTERVALO("salida");
+    std::cout << "Trama [B," << largo << "] -> Fragmento '";
+    std::cout.write(carga, largo);
+    std::cout << "' decodificado como '";
+    std::cout.write(decodificado, largo);
+    std::cout << "'. Mensaje: ";
+    lista->imprimirParcial();
+    std::cout << std::endl;
+}
+
+// Tipo de trama
+char TramaCargaMasiva::getTipo() const {
+    return 'B';
+}
@@ -0,0 +1,93 @@
+// ============================================================================
+// TramaCargaMasiva.h - Trama de Carga Masiva (Tipo B)
+// ============================================================================
+
+#ifndef TRAMA_CARGA_MASIVA_H
+#define TRAMA_CARGA_MASIVA_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "PoolNodos.h"
+
+/**
+ * @class TramaCargaMasiva
+ * @brief Trama que trae una cadena completa de caracteres a decodificar
+ * 
+ * Formato del protocolo: B,N,XXXX
+ * Donde N es la cantidad de caracteres de la carga y XXXX la carga cruda.
+ * Equivale a N tramas L seguidas con la misma rotación, pero la carga se
+ * decodifica en una sola pasada (RotorDeMapeo::mapearBloque) y se agrega
+ * a la lista de una vez (ListaDeCarga::insertarBloque).
+ * 
+ * La carga vive dentro del objeto y el objeto sale del pool del hilo,
+ * así que crear una trama B no pide memoria al sistema.
+ * 
+ * Ejemplo: "B,4,HOLA" -> Carga "HOLA" decodificado con la rotación actual
+ */
+class TramaCargaMasiva : public TramaBase {
+public:
+    static const int MAX_CARGA = 1024;  ///< Caracteres máximos por trama
+
+private:
+    int largo;                  ///< Cantidad de caracteres
+    char carga[MAX_CARGA];      ///< Caracteres crudos (sin decodificar)
+
+public:
+
+    /**
+     * @brief Constructor - Copia la carga cruda
+     * @param datos Caracteres de la trama
+     * @param n Cantidad de caracteres (0..MAX_CARGA)
+     */
+    TramaCargaMasiva(const char* datos, int n);
+    
+    /**
+     * @brief Procesa la trama: decodifica y almacena toda la carga
+     * @param carga Lista donde se insertarán los caracteres decodificados
+     * @param rotor Rotor que aplicará la transformación César
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Tipo de trama
+     * @return 'B'
+     */
+    char getTipo() const override;
+    
+    /**
+     * @brief Carga cruda (sin decodificar, sin '\0' final)
+     */
+    const char* getCarga() const { return carga; }
+    
+    /**
+     * @brief Cantidad de caracteres de la carga
+     */
+    int getLargo() const { return largo; }
+    
+    /**
+     * @brief Reserva la trama en el pool del hilo (sin malloc por trama)
+     * @param tam Tamaño pedido por new
+     */
+    static void* operator new(size_t tam);
+    
+    /**
+     * @brief Devuelve la trama al pool del hilo que la creó
+     * @param p Memoria de la trama destruida
+     * @param tam Tamaño del objeto destruido
+     */
+    static void operator delete(void* p, size_t tam);
+    
+    /**
+     * @brief Estadísticas del pool de TramaCargaMasiva del hilo actual
+     */
+    static const EstadisticasPool& getEstadisticasPool();
+    
+    /**
+     * @brief Deja bloques listos en el pool del hilo actual
+     * @param n Tramas vivas a cubrir sin pedir memoria
+     */
+    static void prereservarPool(size_t n);
+};
+
+#endif // TRAMA_CARGA_MASIVA_H
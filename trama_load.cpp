@@ -3,8 +3,34 @@
 // ============================================================================
 
 #include "TramaLoad.h"
+#include "Traza.h"
 #include <iostream>
 
+// Reserva desde el pool del hilo
+void* TramaLoad::operator new(size_t tam) {
+    if(tam != sizeof(TramaLoad)) return ::operator new(tam);
+    return PoolNodos<TramaLoad>::delHilo().reservar();
+}
+
+// Devolución al pool del hilo
+void TramaLoad::operator delete(void* p, size_t tam) {
+    if(tam != sizeof(TramaLoad)) {
+        ::operator delete(p);
+        return;
+    }
+    PoolNodos<TramaLoad>::delHilo().liberar(p);
+}
+
+// Estadísticas del pool
+const EstadisticasPool& TramaLoad::getEstadisticasPool() {
+    return PoolNodos<TramaLoad>::delHilo().getEstadisticas();
+}
+
+// Prerreserva en el pool del hilo
+void TramaLoad::prereservarPool(size_t n) {
+    PoolNodos<TramaLoad>::delHilo().prereservar(n);
+}
+
 // Constructor
 TramaLoad::TramaLoad(char c) : caracter(c) {}
 
@@ -15,11 +41,23 @@ void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     
     // Insertar en la lista de carga
     carga->insertarAlFinal(decodificado);
+    if(!detalle) return;
     
     // Mostrar información de debug
+    TRAZA_INTERVALO("salida");
     std::cout << "Trama [L," << caracter << "] -> Fragmento '" 
               << caracter << "' decodificado como '" << decodificado 
               << "'. Mensaje: ";
     carga->imprimirParcial();
     std::cout << std::endl;
 }
+
+// Tipo de trama
+char TramaLoad::getTipo() const {
+    return 'L';
+}
+
+// Carácter crudo
+char TramaLoad::getCaracter() const {
+    return caracter;
+}
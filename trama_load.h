@@ -8,6 +8,7 @@
 #include "TramaBase.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "PoolNodos.h"
 
 /**
  * @class TramaLoad
@@ -41,6 +42,41 @@ public:
      * 3. Muestra información de debug en consola
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Tipo de trama
+     * @return 'L'
+     */
+    char getTipo() const override;
+    
+    /**
+     * @brief Carácter crudo (sin decodificar) que trae la trama
+     */
+    char getCaracter() const;
+    
+    /**
+     * @brief Reserva la trama en el pool del hilo (sin malloc por trama)
+     * @param tam Tamaño pedido por new
+     */
+    static void* operator new(size_t tam);
+    
+    /**
+     * @brief Devuelve la trama al pool del hilo que la creó
+     * @param p Memoria de la trama destruida
+     * @param tam Tamaño del objeto destruido
+     */
+    static void operator delete(void* p, size_t tam);
+    
+    /**
+     * @brief Estadísticas del pool de TramaLoad del hilo actual
+     */
+    static const EstadisticasPool& getEstadisticasPool();
+    
+    /**
+     * @brief Deja bloques listos en el pool del hilo actual
+     * @param n Tramas vivas a cubrir sin pedir memoria
+     */
+    static void prereservarPool(size_t n);
 };
 
 #endif // TRAMA_LOAD_H
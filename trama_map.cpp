@@ -3,17 +3,58 @@
 // ============================================================================
 
 #include "TramaMap.h"
+#include "Traza.h"
 #include <iostream>
 
+// Reserva desde el pool del hilo
+void* TramaMap::operator new(size_t tam) {
+    if(tam != sizeof(TramaMap)) return ::operator new(tam);
+    return PoolNodos<TramaMap>::delHilo().reservar();
+}
+
+// Devolución al pool del hilo
+void TramaMap::operator delete(void* p, size_t tam) {
+    if(tam != sizeof(TramaMap)) {
+        ::operator delete(p);
+        return;
+    }
+    PoolNodos<TramaMap>::delHilo().liberar(p);
+}
+
+// Estadísticas del pool
+const EstadisticasPool& TramaMap::getEstadisticasPool() {
+    return PoolNodos<TramaMap>::delHilo().getEstadisticas();
+}
+
+// Prerreserva en el pool del hilo
+void TramaMap::prereservarPool(size_t n) {
+    PoolNodos<TramaMap>::delHilo().prereservar(n);
+}
+
 // Constructor
 TramaMap::TramaMap(int n) : rotacion(n) {}
 
 // Procesar trama de mapeo
 void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     // Rotar el rotor
-    rotor->rotar(rotacion);
+    {
+        TRAZA_INTERVALO("rotar");
+        rotor->rotar(rotacion);
+    }
+    if(!detalle) return;
     
     // Mostrar información de debug
+    TRAZA_INTERVALO("salida");
     std::cout << "Trama [M," << rotacion << "] -> ROTANDO ROTOR " 
               << (rotacion >= 0 ? "+" : "") << rotacion << std::endl;
 }
+
+// Tipo de trama
+char TramaMap::getTipo() const {
+    return 'M';
+}
+
+// Rotación de la trama
+int TramaMap::getRotacion() const {
+    return rotacion;
+}
@@ -0,0 +1,198 @@
+// ============================================================================
+// Traza.cpp - Implementación del Trazado de Eventos por Trama
+// ============================================================================
+
+#include "Traza.h"
+
+#ifdef PRT7_TRAZA
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <mutex>
+
+/**
+ * @struct EventoTraza
+ * @brief Un intervalo en el anillo (atómico: el exportador lo lee en paralelo)
+ */
+struct EventoTraza {
+    std::atomic<const char*> nombre;
+    std::atomic<long long> inicio;      ///< Marca de comienzo
+    std::atomic<long long> duracion;    ///< En unidades de marca()
+};
+
+/**
+ * @struct AnilloTraza
+ * @brief Intervalos de un hilo; sólo ese hilo escribe
+ * 
+ * El escritor anuncia el índice en "iniciados" antes de tocar la casilla
+ * y lo confirma en "escritos" después. Un lector que copia las casillas
+ * y luego relee "iniciados" sabe cuáles pudieron sobrescribirse a medias.
+ */
+struct AnilloTraza {
+    EventoTraza eventos[Traza::CAPACIDAD];
+    std::atomic<unsigned long> iniciados;   ///< Índices reclamados por el escritor
+    std::atomic<unsigned long> escritos;    ///< Índices completos
+    int tid;                                ///< Identificador en la exportación
+    char nombre[32];                        ///< Nombre del hilo (protegido por mutexAnillos)
+    AnilloTraza* siguiente;                 ///< Lista global de anillos
+};
+
+std::atomic<bool> Traza::activa(false);
+
+/// Anillos de todos los hilos; no se liberan, un hilo puede terminar antes de exportar
+static AnilloTraza* anillos = nullptr;
+static int numAnillos = 0;
+static std::mutex mutexAnillos;
+
+static char rutaSalida[512];
+static long long origenNs = 0;         ///< Reloj monótono al activar
+static long long origenMarca = 0;       ///< marca() al activar
+static volatile sig_atomic_t exportacionPedida = 0;
+
+static thread_local AnilloTraza* anilloDelHilo = nullptr;
+
+/**
+ * @brief Anillo del hilo actual, creado y registrado en el primer uso
+ */
+static AnilloTraza* anilloActual() {
+    if(anilloDelHilo) return anilloDelHilo;
+    
+    AnilloTraza* a = new AnilloTraza();
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    a->tid = numAnillos++;
+    snprintf(a->nombre, sizeof(a->nombre), "hilo %d", a->tid);
+    a->siguiente = anillos;
+    anillos = a;
+    anilloDelHilo = a;
+    return a;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Manejador de SIGUSR1: sólo marca el pedido
+ */
+static void pedirExportacion(int) {
+    exportacionPedida = 1;
+}
+#endif
+
+/**
+ * @brief Exportación final (registrada con atexit)
+ */
+static void exportarAlSalir() {
+    if(Traza::exportar()) {
+        std::cerr << "[INFO] Traza escrita en " << rutaSalida << std::endl;
+    }
+}
+
+// Activar el registro
+void Traza::activar(const char* ruta) {
+    if(activa.load()) return;
+    snprintf(rutaSalida, sizeof(rutaSalida), "%s", ruta);
+    origenNs = ahoraNs();
+    origenMarca = marca();
+    activa.store(true);
+    atexit(exportarAlSalir);
+#ifndef _WIN32
+    signal(SIGUSR1, pedirExportacion);
+#endif
+}
+
+// Nombre del hilo actual
+void Traza::nombrarHilo(const char* nombre) {
+    if(!estaActiva()) return;
+    AnilloTraza* a = anilloActual();
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    snprintf(a->nombre, sizeof(a->nombre), "%s", nombre);
+}
+
+// Agregar un intervalo (sin bloqueos)
+void Traza::registrar(const char* nombre, long long inicio, long long fin) {
+    AnilloTraza* a = anilloActual();
+    unsigned long i = a->escritos.load(std::memory_order_relaxed);
+    
+    a->iniciados.store(i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    EventoTraza& e = a->eventos[i & (CAPACIDAD - 1)];
+    e.nombre.store(nombre, std::memory_order_relaxed);
+    e.inicio.store(inicio, std::memory_order_relaxed);
+    e.duracion.store(fin - inicio, std::memory_order_relaxed);
+    a->escritos.store(i + 1, std::memory_order_release);
+}
+
+// Escribir el JSON de todos los anillos
+bool Traza::exportar() {
+    if(!activa.load()) return false;
+    
+    char temporal[540];
+    snprintf(temporal, sizeof(temporal), "%s.tmp", rutaSalida);
+    FILE* f = fopen(temporal, "w");
+    if(!f) {
+        std::cerr << "[ERROR] No se pudo escribir la traza en " << temporal << std::endl;
+        return false;
+    }
+    
+    // Conversión de marcas a microsegundos, medida sobre toda la ejecución
+    long long transcurridoMarca = marca() - origenMarca;
+    long long transcurridoNs = ahoraNs() - origenNs;
+    double usPorMarca = transcurridoMarca > 0 ? transcurridoNs / 1000.0 / transcurridoMarca : 0.001;
+    
+    struct Copia {
+        const char* nombre;
+        long long inicio;
+        long long duracion;
+    };
+    Copia* copia = new Copia[CAPACIDAD];
+    bool primero = true;
+    
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    
+    std::lock_guard<std::mutex> lock(mutexAnillos);
+    for(AnilloTraza* a = anillos; a; a = a->siguiente) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s\"}}", primero ? "" : ",\n", a->tid, a->nombre);
+        primero = false;
+        
+        // Copiar lo confirmado y descartar lo que el escritor pudo pisar
+        unsigned long hasta = a->escritos.load(std::memory_order_acquire);
+        unsigned long desde = hasta > CAPACIDAD ? hasta - CAPACIDAD : 0;
+        for(unsigned long i = desde; i < hasta; i++) {
+            EventoTraza& e = a->eventos[i & (CAPACIDAD - 1)];
+            Copia& c = copia[i - desde];
+            c.nombre = e.nombre.load(std::memory_order_relaxed);
+            c.inicio = e.inicio.load(std::memory_order_relaxed);
+            c.duracion = e.duracion.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        unsigned long iniciados = a->iniciados.load(std::memory_order_relaxed);
+        unsigned long validos = iniciados > CAPACIDAD ? iniciados - CAPACIDAD : 0;
+        
+        for(unsigned long i = desde > validos ? desde : validos; i < hasta; i++) {
+            const Copia& c = copia[i - desde];
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f}", c.nombre, a->tid,
+                    (c.inicio - origenMarca) * usPorMarca, c.duracion * usPorMarca);
+        }
+    }
+    
+    fprintf(f, "\n]}\n");
+    delete[] copia;
+    
+    bool ok = fclose(f) == 0 && rename(temporal, rutaSalida) == 0;
+    if(!ok) std::cerr << "[ERROR] No se pudo escribir la traza en " << rutaSalida << std::endl;
+    return ok;
+}
+
+// Exportar si llegó SIGUSR1
+void Traza::atenderPedido() {
+    if(!exportacionPedida) return;
+    exportacionPedida = 0;
+    if(exportar()) {
+        std::cerr << "[INFO] Traza escrita en " << rutaSalida << std::endl;
+    }
+}
+
+#endif // PRT7_TRAZA
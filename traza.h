@@ -0,0 +1,147 @@
+// ============================================================================
+// Traza.h - Trazado de Eventos por Trama (formato Chrome Trace)
+// ============================================================================
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+/**
+ * @file Traza.h
+ * @brief Intervalos por trama en anillos por hilo, exportados como JSON
+ * 
+ * Los contadores agregados no muestran por qué se atasca una trama en
+ * particular. Con PRT7_TRAZA definido, cada lectura, parseo, procesar(),
+ * escritura de salida y rotación del rotor deja un intervalo (nombre,
+ * inicio, duración) en un anillo propio del hilo que lo ejecuta. Los
+ * anillos se exportan en el formato Trace Event de Chrome (abrir con
+ * chrome://tracing o ui.perfetto.dev) al salir o al recibir SIGUSR1.
+ * 
+ * Sin PRT7_TRAZA las macros se expanden a nada y este módulo no se compila.
+ * Con PRT7_TRAZA pero sin activar(), cada intervalo cuesta una lectura
+ * atómica; activo, dos lecturas del contador de ciclos (TSC en x86, el
+ * reloj monótono en otras arquitecturas) y unas escrituras en el anillo,
+ * sin bloqueos ni reservas. Los ciclos se pasan a tiempo al exportar.
+ */
+
+#ifdef PRT7_TRAZA
+
+#include <atomic>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @class Traza
+ * @brief Registro global de los anillos de cada hilo
+ */
+class Traza {
+private:
+    static std::atomic<bool> activa;    ///< activar() ya fue llamado
+
+public:
+    static const unsigned long CAPACIDAD = 1UL << 16;   ///< Intervalos por hilo (potencia de 2)
+    
+    /**
+     * @brief Empieza a registrar y programa la exportación al salir
+     * @param ruta Archivo JSON de destino
+     * 
+     * También instala el manejador de SIGUSR1 (en POSIX), que sólo marca
+     * el pedido; el bucle que corresponda llama a atenderPedido().
+     */
+    static void activar(const char* ruta);
+    
+    /**
+     * @brief Indica si se están registrando intervalos
+     */
+    static bool estaActiva() { return activa.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Nombre del hilo que llama en la exportación (ej: "epoll")
+     */
+    static void nombrarHilo(const char* nombre);
+    
+    /**
+     * @brief Agrega un intervalo al anillo del hilo que llama
+     * @param nombre Literal con el nombre del intervalo
+     * @param inicio Comienzo (marca())
+     * @param fin Final (marca())
+     */
+    static void registrar(const char* nombre, long long inicio, long long fin);
+    
+    /**
+     * @brief Escribe todos los anillos en el archivo de activar()
+     * @return true si se pudo escribir
+     * 
+     * Puede llamarse mientras otros hilos registran: cada anillo se copia
+     * y se descartan los intervalos que se sobrescribieron durante la copia.
+     */
+    static bool exportar();
+    
+    /**
+     * @brief Exporta si llegó SIGUSR1 desde la última llamada
+     */
+    static void atenderPedido();
+    
+    /**
+     * @brief Marca de tiempo barata: ciclos del TSC en x86, si no nanosegundos
+     */
+    static long long marca() {
+#if defined(__x86_64__) || defined(__i386__)
+        return (long long)__rdtsc();
+#else
+        return ahoraNs();
+#endif
+    }
+    
+    /**
+     * @brief Nanosegundos del reloj monótono
+     */
+    static long long ahoraNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * @class IntervaloTraza
+ * @brief Registra el intervalo que dura su ámbito
+ */
+class IntervaloTraza {
+private:
+    const char* nombre;     ///< Nombre del intervalo
+    long long inicio;       ///< Comienzo (0 = trazado inactivo)
+
+public:
+    explicit IntervaloTraza(const char* n)
+        : nombre(n), inicio(Traza::estaActiva() ? Traza::marca() : 0) {}
+    ~IntervaloTraza() {
+        if(inicio) Traza::registrar(nombre, inicio, Traza::marca());
+    }
+};
+
+#define TRAZA_UNIR2(a, b) a##b
+#define TRAZA_UNIR(a, b) TRAZA_UNIR2(a, b)
+
+/// Intervalo con el nombre dado hasta el fin del ámbito actual
+#define TRAZA_INTERVALO(nombre) IntervaloTraza TRAZA_UNIR(intervaloTraza, __LINE__)(nombre)
+/// Marca el comienzo de un intervalo que quizá no se registre
+#define TRAZA_MARCA(var) long long var = Traza::estaActiva() ? Traza::marca() : 0
+/// Registra el intervalo abierto con TRAZA_MARCA
+#define TRAZA_CERRAR(nombre, var) do { if(var) Traza::registrar(nombre, var, Traza::marca()); } while(0)
+/// Nombre del hilo actual en la exportación
+#define TRAZA_HILO(nombre) Traza::nombrarHilo(nombre)
+/// Exporta si se pidió con SIGUSR1
+#define TRAZA_ATENDER() Traza::atenderPedido()
+
+#else
+
+#define TRAZA_INTERVALO(nombre) do {} while(0)
+#define TRAZA_MARCA(var) do {} while(0)
+#define TRAZA_CERRAR(nombre, var) do {} while(0)
+#define TRAZA_HILO(nombre) do {} while(0)
+#define TRAZA_ATENDER() do {} while(0)
+
+#endif // PRT7_TRAZA
+
+#endif // TRAZA_H